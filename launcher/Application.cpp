@@ -109,6 +109,7 @@
 #include "net/HttpMetaCache.h"
 
 #include "java/JavaInstallList.h"
+#include "java/JavaProbeCache.h"
 
 #include "updater/ExternalUpdater.h"
 
@@ -129,6 +130,7 @@
 #include <stdlib.h>
 #include <sys.h>
 #include "SysInfo.h"
+#include "TimingTrace.h"
 
 #ifdef Q_OS_LINUX
 #include <dlfcn.h>
@@ -244,7 +246,10 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
           { { "a", "profile" }, "Use the account specified by its profile name (only valid in combination with --launch)", "profile" },
           { "alive", "Write a small '" + liveCheckFile + "' file after the launcher starts" },
           { { "I", "import" }, "Import instance or resource from specified local path or URL", "url" },
-          { "show", "Opens the window for the specified instance (by instance ID)", "show" } });
+          { "show", "Opens the window for the specified instance (by instance ID)", "show" },
+          { "trace-startup",
+            "Record how long each startup phase and instance launch takes and write it to logs/startup-trace.json and "
+            "logs/launch-<instance>.trace.json" } });
     // Has to be positional for some OS to handle that properly
     parser.addPositionalArgument("URL", "Import the resource(s) at the given URL(s) (same as -I / --import)", "[URL...]");
 
@@ -253,6 +258,11 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     parser.process(arguments());
 
+    if (parser.isSet("trace-startup")) {
+        m_startupTrace = std::make_unique<TimingTrace>();
+        m_saveTraces = true;
+    }
+
     m_instanceIdToLaunch = parser.value("launch");
     m_serverToJoin = parser.value("server");
     m_worldToJoin = parser.value("world");
@@ -554,6 +564,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // Initialize application settings
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Settings", "startup");
         // Provide a fallback for migration from PolyMC
         m_settings.reset(new INISettingsObject({ BuildConfig.LAUNCHER_CONFIGFILE, "polymc.cfg", "multimc.cfg" }, this));
 
@@ -809,6 +820,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // initialize network access and proxy setup
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Network", "startup");
         m_network.reset(new QNetworkAccessManager());
         QString proxyTypeStr = settings()->get("ProxyType").toString();
         QString addr = settings()->get("ProxyAddr").toString();
@@ -821,6 +833,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // load translations
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Translations", "startup");
         m_translations.reset(new TranslationsModel("translations"));
         auto bcp47Name = m_settings->get("Language").toString();
         m_translations->selectLanguage(bcp47Name);
@@ -830,20 +843,25 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // Instance icons
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Instance icons", "startup");
         auto setting = APPLICATION->settings()->getSetting("IconsDir");
         QStringList instFolders = { ":/icons/multimc/32x32/instances/", ":/icons/multimc/50x50/instances/",
                                     ":/icons/multimc/128x128/instances/", ":/icons/multimc/scalable/instances/" };
-        m_icons.reset(new IconList(instFolders, setting->get().toString()));
+        m_icons.reset(new IconList(instFolders, setting->get().toString(), FS::PathCombine("cache", "icons")));
         connect(setting.get(), &Setting::SettingChanged,
                 [&](const Setting&, QVariant value) { m_icons->directoryChanged(value.toString()); });
         qDebug() << "<> Instance icons initialized.";
     }
 
     // Themes
-    m_themeManager = std::make_unique<ThemeManager>();
+    {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Themes", "startup");
+        m_themeManager = std::make_unique<ThemeManager>();
+    }
 
     // initialize and load all instances
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Instances", "startup");
         auto InstDirSetting = m_settings->getSetting("InstanceDir");
         // instance path: check for problems with '!' in instance path and warn the user in the log
         // and remember that we have to show him a dialog when the gui starts (if it does so)
@@ -861,6 +879,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // and accounts
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Accounts", "startup");
         m_accounts.reset(new AccountList(this));
         qDebug() << "Loading accounts...";
         m_accounts->setListFilePath("accounts.json", true);
@@ -871,6 +890,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     // init the http meta cache
     {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Meta cache", "startup");
         m_metacache.reset(new HttpMetaCache("metacache"));
         m_metacache->addBase("asset_indexes", QDir("assets/indexes").absolutePath());
         m_metacache->addBase("libraries", QDir("libraries").absolutePath());
@@ -883,6 +903,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("FlameMods", QDir("cache/FlameMods").absolutePath());
         m_metacache->addBase("ModrinthPacks", QDir("cache/ModrinthPacks").absolutePath());
         m_metacache->addBase("ModrinthModpacks", QDir("cache/ModrinthModpacks").absolutePath());
+        m_metacache->addBase("ModPlatformAPI", QDir("cache/ModPlatformAPI").absolutePath(), true);
         m_metacache->addBase("translations", QDir("translations").absolutePath());
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->addBase("java", QDir("cache/java").absolutePath());
@@ -1064,7 +1085,10 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         return;
     }
 
-    m_themeManager->applyCurrentlySelectedTheme(true);
+    {
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Apply theme", "startup");
+        m_themeManager->applyCurrentlySelectedTheme(true);
+    }
     performMainStartupAction();
 }
 
@@ -1182,6 +1206,23 @@ void Application::setupWizardFinished(int status)
     performMainStartupAction();
 }
 
+void Application::finishStartupTrace()
+{
+    if (!m_startupTrace) {
+        return;
+    }
+    m_startupTrace->instant("Startup done", "startup");
+    qDebug() << "Startup timings:";
+    for (auto& line : m_startupTrace->summary()) {
+        qDebug().noquote() << "  " + line;
+    }
+    auto path = FS::PathCombine("logs", "startup-trace.json");
+    if (m_startupTrace->save(path)) {
+        qDebug() << "Startup timings written to" << path;
+    }
+    m_startupTrace.reset();
+}
+
 void Application::performMainStartupAction()
 {
     m_status = Application::Initialized;
@@ -1209,6 +1250,7 @@ void Application::performMainStartupAction()
                 qDebug() << "   Launching with account" << m_profileToUse;
             }
 
+            finishStartupTrace();
             launch(inst, true, false, targetToJoin, accountToUse);
             return;
         }
@@ -1218,14 +1260,17 @@ void Application::performMainStartupAction()
         if (inst) {
             qDebug() << "<> Showing window of instance " << m_instanceIdToShowWindowOf;
             showInstanceWindow(inst);
+            finishStartupTrace();
             return;
         }
     }
     if (!m_mainWindow) {
         // normal main window
+        TimingTrace::Scope traceScope(m_startupTrace.get(), "Main window", "startup");
         showMainWindow(false);
         qDebug() << "<> Main window shown.";
     }
+    finishStartupTrace();
 
     // initialize the updater
     if (updaterEnabled()) {
@@ -1356,6 +1401,15 @@ std::shared_ptr<JavaInstallList> Application::javalist()
     return m_javalist;
 }
 
+std::shared_ptr<JavaProbeCache> Application::javaProbeCache()
+{
+    if (!m_javaProbeCache) {
+        m_javaProbeCache.reset(new JavaProbeCache(FS::PathCombine("cache", "java_probes.json")));
+        m_javaProbeCache->Load();
+    }
+    return m_javaProbeCache;
+}
+
 QIcon Application::getThemedIcon(const QString& name)
 {
     if (name == "logo") {
@@ -63,6 +63,7 @@ class AccountList;
 class IconList;
 class QNetworkAccessManager;
 class JavaInstallList;
+class JavaProbeCache;
 class ExternalUpdater;
 class BaseProfilerFactory;
 class BaseDetachedToolFactory;
@@ -70,6 +71,7 @@ class TranslationsModel;
 class ITheme;
 class MCEditTool;
 class ThemeManager;
+class TimingTrace;
 class IconTheme;
 
 namespace Meta {
@@ -109,6 +111,9 @@ class Application : public QApplication {
 
     QIcon getThemedIcon(const QString& name);
 
+    /// whether timing traces are written to files, enabled by --trace-startup
+    bool saveTraces() const { return m_saveTraces; }
+
     ThemeManager* themeManager() { return m_themeManager.get(); }
 
     shared_qobject_ptr<ExternalUpdater> updater() { return m_updater; }
@@ -119,6 +124,8 @@ class Application : public QApplication {
 
     std::shared_ptr<JavaInstallList> javalist();
 
+    std::shared_ptr<JavaProbeCache> javaProbeCache();
+
     std::shared_ptr<InstanceList> instances() const { return m_instances; }
 
     std::shared_ptr<IconList> icons() const { return m_icons; }
@@ -219,6 +226,7 @@ class Application : public QApplication {
     bool handleDataMigration(const QString& currentData, const QString& oldData, const QString& name, const QString& configFile) const;
     bool createSetupWizard();
     void performMainStartupAction();
+    void finishStartupTrace();
 
     // sets the fatal error message and m_status to Failed.
     void showFatalErrorMessage(const QString& title, const QString& content);
@@ -243,11 +251,15 @@ class Application : public QApplication {
     std::shared_ptr<InstanceList> m_instances;
     std::shared_ptr<IconList> m_icons;
     std::shared_ptr<JavaInstallList> m_javalist;
+    std::shared_ptr<JavaProbeCache> m_javaProbeCache;
     std::shared_ptr<TranslationsModel> m_translations;
     std::shared_ptr<GenericPageProvider> m_globalSettingsProvider;
     std::unique_ptr<MCEditTool> m_mcedit;
     QSet<QString> m_features;
     std::unique_ptr<ThemeManager> m_themeManager;
+    // only set when started with --trace-startup
+    std::unique_ptr<TimingTrace> m_startupTrace;
+    bool m_saveTraces = false;
 
     QMap<QString, std::shared_ptr<BaseProfilerFactory>> m_profilers;
 
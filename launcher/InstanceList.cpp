@@ -48,9 +48,11 @@
 #include <QStack>
 #include <QTextStream>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUuid>
 #include <QXmlStreamReader>
+#include <QtConcurrentRun>
 
 #include "BaseInstance.h"
 #include "ExponentialSeries.h"
@@ -458,22 +460,39 @@ QList<InstanceId> InstanceList::discoverInstances()
     return out;
 }
 
+static INIFile readInstanceConfig(const QString& path)
+{
+    INIFile config;
+    config.loadFile(path);
+    return config;
+}
+
 InstanceList::InstListError InstanceList::loadList()
 {
     auto existingIds = getIdMapping(m_instances);
 
-    QList<InstancePtr> newList;
-
+    QList<InstanceId> newIds;
     for (auto& id : discoverInstances()) {
         if (existingIds.contains(id)) {
             auto instPair = existingIds[id];
             existingIds.remove(id);
             qDebug() << "Should keep and soft-reload" << id;
         } else {
-            InstancePtr instPtr = loadInstance(id);
-            if (instPtr) {
-                newList.append(instPtr);
-            }
+            newIds.append(id);
+        }
+    }
+
+    // reading the configs is what makes loading slow with a lot of instances, so read them all at once in the background
+    QList<QFuture<INIFile>> configs;
+    for (auto& id : newIds) {
+        configs.append(QtConcurrent::run(QThreadPool::globalInstance(), readInstanceConfig, FS::PathCombine(m_instDir, id, "instance.cfg")));
+    }
+
+    QList<InstancePtr> newList;
+    for (int i = 0; i < newIds.size(); i++) {
+        InstancePtr instPtr = loadInstance(newIds[i], configs[i].result());
+        if (instPtr) {
+            newList.append(instPtr);
         }
     }
 
@@ -621,14 +640,14 @@ void InstanceList::propertiesChanged(BaseInstance* inst)
     }
 }
 
-InstancePtr InstanceList::loadInstance(const InstanceId& id)
+InstancePtr InstanceList::loadInstance(const InstanceId& id, const INIFile& config)
 {
     if (!m_groupsLoaded) {
         loadGroupList();
     }
 
     auto instanceRoot = FS::PathCombine(m_instDir, id);
-    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"));
+    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"), config);
     InstancePtr inst;
 
     instanceSettings->registerSetting("InstanceType", "");
@@ -46,6 +46,7 @@
 
 class QFileSystemWatcher;
 class InstanceTask;
+class INIFile;
 struct InstanceName;
 
 using InstanceId = QString;
@@ -177,7 +178,7 @@ class InstanceList : public QAbstractListModel {
     void loadGroupList();
     void saveGroupList();
     QList<InstanceId> discoverInstances();
-    InstancePtr loadInstance(const InstanceId& id);
+    InstancePtr loadInstance(const InstanceId& id, const INIFile& config);
 
     void increaseGroupCount(const QString& group);
     void decreaseGroupCount(const QString& group);
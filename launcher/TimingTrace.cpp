@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TimingTrace.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "FileSystem.h"
+#include "StringUtils.h"
+
+TimingTrace::Scope::Scope(TimingTrace* trace, const QString& name, const QString& category) : m_trace(trace)
+{
+    if (m_trace)
+        m_id = m_trace->begin(name, category);
+}
+
+TimingTrace::Scope::~Scope()
+{
+    if (m_trace)
+        m_trace->end(m_id);
+}
+
+TimingTrace::TimingTrace()
+{
+    m_timer.start();
+}
+
+qint64 TimingTrace::elapsed() const
+{
+    return m_timer.nsecsElapsed();
+}
+
+int TimingTrace::begin(const QString& name, const QString& category)
+{
+    // track 0 is kept for instants, everything else gets the lowest track that is free right now
+    int track = 1;
+    while (track < m_busyTracks.size() && m_busyTracks[track])
+        track++;
+    while (m_busyTracks.size() <= track)
+        m_busyTracks.append(false);
+    m_busyTracks[track] = true;
+
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.start = elapsed();
+    event.track = track;
+    m_events.append(event);
+    return m_events.size() - 1;
+}
+
+void TimingTrace::end(int id, qint64 bytes)
+{
+    if (id < 0 || id >= m_events.size())
+        return;
+    auto& event = m_events[id];
+    if (event.end >= 0)
+        return;
+    event.end = elapsed();
+    event.bytes = bytes;
+    m_busyTracks[event.track] = false;
+}
+
+void TimingTrace::instant(const QString& name, const QString& category)
+{
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.start = event.end = elapsed();
+    event.instant = true;
+    m_events.append(event);
+}
+
+const TimingTrace::Event* TimingTrace::find(const QString& name) const
+{
+    for (auto& event : m_events) {
+        if (event.name == name)
+            return &event;
+    }
+    return nullptr;
+}
+
+static QString formatMs(qint64 ns)
+{
+    return QString::number(ns / 1000000.0, 'f', 1);
+}
+
+QStringList TimingTrace::summary() const
+{
+    QStringList lines;
+    auto now = elapsed();
+    for (auto& event : m_events) {
+        if (event.instant) {
+            lines << QString("%1 ms: %2").arg(formatMs(event.start), event.name);
+            continue;
+        }
+        auto end = event.end < 0 ? now : event.end;
+        auto line = QString("%1 ms: %2 took %3 ms").arg(formatMs(event.start), event.name, formatMs(end - event.start));
+        if (event.end < 0)
+            line += " (still running)";
+        if (event.bytes > 0)
+            line += QString(", %1 received").arg(StringUtils::humanReadableFileSize(event.bytes, true));
+        lines << line;
+    }
+    return lines;
+}
+
+QByteArray TimingTrace::toChromeTrace() const
+{
+    QJsonArray traceEvents;
+    auto now = elapsed();
+    for (auto& event : m_events) {
+        QJsonObject obj;
+        obj["name"] = event.name;
+        obj["cat"] = event.category.isEmpty() ? QString("default") : event.category;
+        obj["pid"] = 1;
+        obj["tid"] = event.track;
+        obj["ts"] = event.start / 1000.0;
+        if (event.instant) {
+            obj["ph"] = "i";
+            obj["s"] = "g";
+        } else {
+            obj["ph"] = "X";
+            obj["dur"] = ((event.end < 0 ? now : event.end) - event.start) / 1000.0;
+            if (event.bytes >= 0)
+                obj["args"] = QJsonObject{ { "bytes", event.bytes } };
+        }
+        traceEvents.append(obj);
+    }
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool TimingTrace::save(const QString& path) const
+{
+    try {
+        FS::write(path, toChromeTrace());
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write timing trace to" << path << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Lightweight recorder for the phases of a long running operation (application startup, instance launch).
+ *
+ * All timestamps come from a monotonic clock started when the trace is created. Events that overlap in time are
+ * placed on separate tracks so the result can be inspected as a timeline with chrome://tracing or Perfetto.
+ */
+class TimingTrace {
+   public:
+    struct Event {
+        QString name;
+        QString category;
+        qint64 start = 0;  // nanoseconds since the trace was created
+        qint64 end = -1;   // -1 while the event is still open
+        qint64 bytes = -1;
+        int track = 0;
+        bool instant = false;
+
+        qint64 duration() const { return end < start ? 0 : end - start; }
+    };
+
+    /** Helper that records a phase for the lifetime of the scope. Does nothing for a null trace. */
+    class Scope {
+       public:
+        Scope(TimingTrace* trace, const QString& name, const QString& category = {});
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+       private:
+        TimingTrace* m_trace;
+        int m_id = -1;
+    };
+
+    TimingTrace();
+
+    /** Nanoseconds since the trace was created. */
+    qint64 elapsed() const;
+
+    /** Opens a phase on the first free track and returns its id, to be passed to end(). */
+    int begin(const QString& name, const QString& category = {});
+    /** Closes a phase, optionally recording the amount of data transferred while it was running. */
+    void end(int id, qint64 bytes = -1);
+    /** Records a point in time, on the main track. */
+    void instant(const QString& name, const QString& category = {});
+
+    const QList<Event>& events() const { return m_events; }
+    const Event* find(const QString& name) const;
+
+    /** Human readable one-line-per-event summary, in start order. */
+    QStringList summary() const;
+    /** The trace in the Chrome trace event format. */
+    QByteArray toChromeTrace() const;
+    /** Writes toChromeTrace() to the path. Returns false (and logs) on failure. */
+    bool save(const QString& path) const;
+
+   private:
+    QElapsedTimer m_timer;
+    QList<Event> m_events;
+    QList<bool> m_busyTracks;
+};
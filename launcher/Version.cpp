@@ -1,50 +1,110 @@
 #include "Version.h"
 
 #include <QDebug>
+#include <QMutex>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QUrl>
 
+#include <limits>
+#include <unordered_set>
+
+namespace {
+struct QStringHasher {
+    size_t operator()(const QString& str) const { return qHash(str); }
+};
+
+/// Interns section suffixes so a Version never owns copies of them
+const QString* internSuffix(QStringView suffix)
+{
+    static QMutex s_lock;
+    static std::unordered_set<QString, QStringHasher> s_pool;
+
+    QMutexLocker locker(&s_lock);
+    // std::unordered_set never moves its nodes, so the pointer stays valid forever
+    return &*s_pool.insert(suffix.toString()).first;
+}
+}  // namespace
+
+Version::Section::Section(QStringView fullString, int start) : m_start(start), m_length(static_cast<int>(fullString.size()))
+{
+    qsizetype cutoff = fullString.size();
+    for (int i = 0; i < fullString.size(); i++) {
+        if (!fullString[i].isDigit()) {
+            cutoff = i;
+            break;
+        }
+    }
+
+    if (cutoff > 0) {
+        m_flags &= ~Null;
+        // mirror QString::toInt(): anything it can't represent reads as 0
+        qint64 num = 0;
+        for (int i = 0; i < cutoff; i++) {
+            const auto c = fullString[i].unicode();
+            if (c < '0' || c > '9' || num > std::numeric_limits<int>::max()) {
+                num = 0;
+                break;
+            }
+            num = num * 10 + (c - '0');
+        }
+        m_numPart = num > std::numeric_limits<int>::max() ? 0 : static_cast<int>(num);
+    }
+
+    auto stringPart = fullString.mid(cutoff);
+    if (!stringPart.isEmpty()) {
+        m_flags &= ~Null;
+        m_stringPart = internSuffix(stringPart);
+        if (stringPart.startsWith(QLatin1Char('+')))
+            m_flags |= Appendix;
+        if (stringPart.startsWith(QLatin1Char('-')) && stringPart.size() > 1)
+            m_flags |= PreRelease;
+        if (stringPart.size() == 1 && stringPart.at(0) == QLatin1Char('.'))
+            m_flags |= Dot;
+    }
+}
+
 Version::Version(QString str) : m_string(std::move(str))
 {
     parse();
 }
 
-#define VERSION_OPERATOR(return_on_different)                                               \
-    bool exclude_our_sections = false;                                                      \
-    bool exclude_their_sections = false;                                                    \
-                                                                                            \
-    const auto size = qMax(m_sections.size(), other.m_sections.size());                     \
-    for (int i = 0; i < size; ++i) {                                                        \
-        Section sec1 = (i >= m_sections.size()) ? Section() : m_sections.at(i);             \
-        Section sec2 = (i >= other.m_sections.size()) ? Section() : other.m_sections.at(i); \
-                                                                                            \
-        { /* Don't include appendixes in the comparison */                                  \
-            if (sec1.isAppendix())                                                          \
-                exclude_our_sections = true;                                                \
-            if (sec2.isAppendix())                                                          \
-                exclude_their_sections = true;                                              \
-                                                                                            \
-            if (exclude_our_sections) {                                                     \
-                sec1 = Section();                                                           \
-                if (sec2.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-                                                                                            \
-            if (exclude_their_sections) {                                                   \
-                sec2 = Section();                                                           \
-                if (sec1.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-        }                                                                                   \
-                                                                                            \
-        if (sec1 != sec2)                                                                   \
-            return return_on_different;                                                     \
+#define VERSION_OPERATOR(return_on_different)                                                     \
+    static const Section s_null;                                                                  \
+    bool exclude_our_sections = false;                                                            \
+    bool exclude_their_sections = false;                                                          \
+                                                                                                  \
+    const auto size = qMax(m_sections.size(), other.m_sections.size());                           \
+    for (int i = 0; i < size; ++i) {                                                              \
+        const Section* sec1 = (i >= m_sections.size()) ? &s_null : &m_sections.at(i);             \
+        const Section* sec2 = (i >= other.m_sections.size()) ? &s_null : &other.m_sections.at(i); \
+                                                                                                  \
+        { /* Don't include appendixes in the comparison */                                        \
+            if (sec1->isAppendix())                                                               \
+                exclude_our_sections = true;                                                      \
+            if (sec2->isAppendix())                                                               \
+                exclude_their_sections = true;                                                    \
+                                                                                                  \
+            if (exclude_our_sections) {                                                           \
+                sec1 = &s_null;                                                                   \
+                if (sec2->isNull())                                                               \
+                    break;                                                                        \
+            }                                                                                     \
+                                                                                                  \
+            if (exclude_their_sections) {                                                         \
+                sec2 = &s_null;                                                                   \
+                if (sec1->isNull())                                                               \
+                    break;                                                                        \
+            }                                                                                     \
+        }                                                                                         \
+                                                                                                  \
+        if (*sec1 != *sec2)                                                                       \
+            return return_on_different;                                                           \
     }
 
 bool Version::operator<(const Version& other) const
 {
-    VERSION_OPERATOR(sec1 < sec2)
+    VERSION_OPERATOR(*sec1 < *sec2)
 
     return false;
 }
@@ -74,38 +134,29 @@ bool Version::operator>=(const Version& other) const
 void Version::parse()
 {
     m_sections.clear();
-    QString currentSection;
 
     if (m_string.isEmpty())
         return;
 
-    auto classChange = [&](QChar lastChar, QChar currentChar) {
-        if (lastChar.isNull())
-            return false;
-        if (lastChar.isDigit() != currentChar.isDigit())
-            return true;
-
-        const QList<QChar> s_separators{ '.', '-', '+' };
-        if (s_separators.contains(currentChar) && currentSection.at(0) != currentChar)
-            return true;
-
-        return false;
-    };
-
-    currentSection += m_string.at(0);
-    for (int i = 1; i < m_string.size(); ++i) {
-        const auto& current_char = m_string.at(i);
-        if (classChange(m_string.at(i - 1), current_char)) {
-            if (!currentSection.isEmpty())
-                m_sections.append(Section(currentSection));
-            currentSection = "";
-        }
+    auto isSeparator = [](QChar c) { return c == QLatin1Char('.') || c == QLatin1Char('-') || c == QLatin1Char('+'); };
+
+    const QStringView view{ m_string };
+    int sectionStart = 0;
+    for (int i = 1; i < view.size(); ++i) {
+        const auto last_char = view.at(i - 1);
+        const auto current_char = view.at(i);
 
-        currentSection += current_char;
+        bool classChange = last_char.isDigit() != current_char.isDigit();
+        if (!classChange && isSeparator(current_char) && view.at(sectionStart) != current_char)
+            classChange = true;
+
+        if (classChange) {
+            m_sections.append(Section(view.mid(sectionStart, i - sectionStart), sectionStart));
+            sectionStart = i;
+        }
     }
 
-    if (!currentSection.isEmpty())
-        m_sections.append(Section(currentSection));
+    m_sections.append(Section(view.mid(sectionStart), sectionStart));
 }
 
 /// qDebug print support for the Version class
@@ -116,10 +167,10 @@ QDebug operator<<(QDebug debug, const Version& v)
     debug.nospace() << "Version{ string: " << v.toString() << ", sections: [ ";
 
     bool first = true;
-    for (auto s : v.m_sections) {
+    for (const auto& s : v.m_sections) {
         if (!first)
             debug.nospace() << ", ";
-        debug.nospace() << s.m_fullString;
+        debug.nospace() << QStringView{ v.m_string }.mid(s.m_start, s.m_length);
         first = false;
     }
 
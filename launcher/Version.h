@@ -61,60 +61,48 @@ class Version {
     friend QDebug operator<<(QDebug debug, const Version& v);
 
    private:
+    /**
+     * A pre-tokenized section of the version string.
+     *
+     * Sections are plain values so comparisons never touch the heap: the numeric part is stored
+     * already parsed, and the textual part points into a process-wide pool of interned strings,
+     * so equal suffixes always share the same pointer.
+     */
     struct Section {
-        explicit Section(QString fullString) : m_fullString(std::move(fullString))
-        {
-            qsizetype cutoff = m_fullString.size();
-            for (int i = 0; i < m_fullString.size(); i++) {
-                if (!m_fullString[i].isDigit()) {
-                    cutoff = i;
-                    break;
-                }
-            }
-
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-            auto numPart = QStringView{ m_fullString }.left(cutoff);
-#else
-            auto numPart = m_fullString.leftRef(cutoff);
-#endif
-
-            if (!numPart.isEmpty()) {
-                m_isNull = false;
-                m_numPart = numPart.toInt();
-            }
-
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-            auto stringPart = QStringView{ m_fullString }.mid(cutoff);
-#else
-            auto stringPart = m_fullString.midRef(cutoff);
-#endif
-
-            if (!stringPart.isEmpty()) {
-                m_isNull = false;
-                m_stringPart = stringPart.toString();
-            }
-        }
+        enum Flag : quint8 { Null = 1 << 0, Appendix = 1 << 1, PreRelease = 1 << 2, Dot = 1 << 3 };
 
         explicit Section() = default;
-
-        bool m_isNull = true;
+        explicit Section(QStringView fullString, int start);
 
         int m_numPart = 0;
-        QString m_stringPart;
+        const QString* m_stringPart = nullptr;  // nullptr when the section has no textual part
+        int m_start = 0;
+        int m_length = 0;
+        quint8 m_flags = Null;
 
-        QString m_fullString;
+        [[nodiscard]] inline bool isNull() const { return m_flags & Null; }
+        [[nodiscard]] inline bool isAppendix() const { return m_flags & Appendix; }
+        [[nodiscard]] inline bool isPreRelease() const { return m_flags & PreRelease; }
+        [[nodiscard]] inline bool hasStringPart() const { return m_stringPart != nullptr; }
 
-        [[nodiscard]] inline bool isAppendix() const { return m_stringPart.startsWith('+'); }
-        [[nodiscard]] inline bool isPreRelease() const { return m_stringPart.startsWith('-') && m_stringPart.length() > 1; }
+        static inline bool stringLess(const QString* lhs, const QString* rhs)
+        {
+            if (lhs == rhs)
+                return false;
+            if (!lhs)
+                return true;
+            if (!rhs)
+                return false;
+            return *lhs < *rhs;
+        }
 
         inline bool operator==(const Section& other) const
         {
-            if (m_isNull && !other.m_isNull)
-                return false;
-            if (!m_isNull && other.m_isNull)
+            if (isNull() != other.isNull())
                 return false;
 
-            if (!m_isNull && !other.m_isNull) {
+            if (!isNull()) {
+                // interned, so equal text means equal pointers
                 return (m_numPart == other.m_numPart) && (m_stringPart == other.m_stringPart);
             }
 
@@ -124,31 +112,32 @@ class Version {
         inline bool operator<(const Section& other) const
         {
             static auto unequal_is_less = [](Section const& non_null) -> bool {
-                if (non_null.m_stringPart.isEmpty())
+                if (!non_null.hasStringPart())
                     return non_null.m_numPart == 0;
-                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.isPreRelease();
+                return !(non_null.m_flags & Dot) && non_null.isPreRelease();
             };
 
-            if (!m_isNull && other.m_isNull)
+            if (!isNull() && other.isNull())
                 return unequal_is_less(*this);
-            if (m_isNull && !other.m_isNull)
+            if (isNull() && !other.isNull())
                 return !unequal_is_less(other);
 
-            if (!m_isNull && !other.m_isNull) {
+            if (!isNull() && !other.isNull()) {
                 if (m_numPart < other.m_numPart)
                     return true;
-                if (m_numPart == other.m_numPart && m_stringPart < other.m_stringPart)
+                if (m_numPart == other.m_numPart && stringLess(m_stringPart, other.m_stringPart))
                     return true;
 
-                if (!m_stringPart.isEmpty() && other.m_stringPart.isEmpty())
+                if (hasStringPart() && !other.hasStringPart())
                     return false;
-                if (m_stringPart.isEmpty() && !other.m_stringPart.isEmpty())
+                if (!hasStringPart() && other.hasStringPart())
                     return true;
 
                 return false;
             }
 
-            return m_fullString < other.m_fullString;
+            // both null, so both full strings are empty
+            return false;
         }
 
         inline bool operator!=(const Section& other) const { return !(*this == other); }
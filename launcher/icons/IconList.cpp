@@ -36,18 +36,96 @@
 
 #include "IconList.h"
 #include <FileSystem.h>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
 #include <QEventLoop>
 #include <QFileSystemWatcher>
+#include <QImageReader>
 #include <QMap>
 #include <QMimeData>
+#include <QPointer>
+#include <QSaveFile>
 #include <QSet>
+#include <QThreadPool>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include "icons/IconUtils.h"
 
 #define MAX_SIZE 1024
+// icons are shown at 48x48 at most, this leaves room for high DPI screens
+#define THUMBNAIL_SIZE 128
 
-IconList::IconList(const QStringList& builtinPaths, QString path, QObject* parent) : QAbstractListModel(parent)
+namespace {
+QString iconKeyForFile(const QFileInfo& file)
+{
+    // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
+    if (!IconUtils::isIconSuffix(file.suffix()))
+        return file.fileName();
+    return file.completeBaseName();
+}
+
+bool writeThumbnail(const QString& path, const QString& thumbnailPath)
+{
+    QImageReader reader(path);
+    const QSize size = reader.size();
+    // small images decode quickly enough, a thumbnail would not be any cheaper
+    if (!size.isValid() || (size.width() <= THUMBNAIL_SIZE && size.height() <= THUMBNAIL_SIZE))
+        return false;
+    reader.setScaledSize(size.scaled(THUMBNAIL_SIZE, THUMBNAIL_SIZE, Qt::KeepAspectRatio));
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Failed to create a thumbnail for" << path << ":" << reader.errorString();
+        return false;
+    }
+    if (!FS::ensureFilePathExists(thumbnailPath))
+        return false;
+    QSaveFile file(thumbnailPath);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+        qWarning() << "Failed to write the icon thumbnail" << thumbnailPath;
+        return false;
+    }
+    return true;
+}
+
+/// thumbnails are named after the contents of the icon, an empty string if the icon can't be read
+QString thumbnailName(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return QString::fromLatin1(hash.result().toHex()) + ".png";
+}
+
+/// the thumbnail of the icon, created if needed, or an empty string if the icon doesn't get one
+QString findThumbnail(const QString& path, const QString& thumbnailDir)
+{
+    auto name = thumbnailName(path);
+    if (name.isEmpty())
+        return {};
+    auto thumbnailPath = FS::PathCombine(thumbnailDir, name);
+    if (QFileInfo::exists(thumbnailPath) || writeThumbnail(path, thumbnailPath))
+        return thumbnailPath;
+    return {};
+}
+
+/// deletes the thumbnails that don't belong to any of the icons, except the ones written after the sweep started
+void sweepThumbnails(const QStringList& iconFiles, const QString& thumbnailDir, const QDateTime& started)
+{
+    QSet<QString> used;
+    for (auto& file : iconFiles)
+        used.insert(thumbnailName(file));
+    for (auto& entry : QDir(thumbnailDir).entryInfoList({ "*.png" }, QDir::Files)) {
+        if (!used.contains(entry.fileName()) && entry.lastModified() < started)
+            QFile::remove(entry.absoluteFilePath());
+    }
+}
+}  // namespace
+
+IconList::IconList(const QStringList& builtinPaths, QString path, QString thumbnailPath, QObject* parent)
+    : QAbstractListModel(parent), m_thumbnailDir(thumbnailPath)
 {
     QSet<QString> builtinNames;
 
@@ -60,8 +138,13 @@ IconList::IconList(const QStringList& builtinPaths, QString path, QObject* paren
         }
     }
     for (auto& builtinName : builtinNames) {
-        addThemeIcon(builtinName);
+        MMCIcon mmc_icon;
+        mmc_icon.m_name = builtinName;
+        mmc_icon.m_key = builtinName;
+        mmc_icon.replace(Builtin, builtinName);
+        icons.push_back(mmc_icon);
     }
+    sortIconList();
 
     m_watcher.reset(new QFileSystemWatcher());
     is_watching = false;
@@ -125,14 +208,9 @@ void IconList::directoryChanged(const QString& path)
 
     for (auto remove : to_remove) {
         qDebug() << "Removing " << remove;
-        QFileInfo rmfile(remove);
-        QString key = rmfile.completeBaseName();
-
-        QString suffix = rmfile.suffix();
-        // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
-        if (!IconUtils::isIconSuffix(suffix))
-            key = rmfile.fileName();
+        QString key = iconKeyForFile(QFileInfo(remove));
 
+        dropThumbnail(remove);
         int idx = getIconIndex(key);
         if (idx == -1)
             continue;
@@ -149,24 +227,49 @@ void IconList::directoryChanged(const QString& path)
         emit iconUpdated(key);
     }
 
+    // Only check that the new files look like images, decoding them is left for when they are shown
+    QList<std::pair<QString, QString>> added;
     for (auto add : to_add) {
-        qDebug() << "Adding " << add;
-
         QFileInfo addfile(add);
-        QString key = addfile.completeBaseName();
-
-        QString suffix = addfile.suffix();
-        // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
-        if (!IconUtils::isIconSuffix(suffix))
-            key = addfile.fileName();
+        if (!IconUtils::isIconSuffix(addfile.suffix()) && QImageReader::imageFormat(add).isEmpty())
+            continue;
+        added.append({ iconKeyForFile(addfile), addfile.filePath() });
+    }
 
-        if (addIcon(key, QString(), addfile.filePath(), IconType::FileBased)) {
-            m_watcher->addPath(add);
-            emit iconUpdated(key);
+    if (added.size() == 1) {
+        auto& [key, file] = added.first();
+        qDebug() << "Adding " << file;
+        if (!addIcon(key, QString(), file, IconType::FileBased))
+            added.clear();
+    } else if (!added.isEmpty()) {
+        // many new icons, usually the initial load, insert them all and sort once
+        qDebug() << "Adding" << added.size() << "icons";
+        beginResetModel();
+        ensureIndexed();
+        for (auto& [key, file] : added) {
+            auto iter = name_index.find(key);
+            if (iter != name_index.end()) {
+                icons[*iter].replace(IconType::FileBased, QIcon(), file);
+                continue;
+            }
+            MMCIcon mmc_icon;
+            mmc_icon.m_key = key;
+            mmc_icon.replace(IconType::FileBased, QIcon(), file);
+            icons.push_back(mmc_icon);
+            name_index[key] = icons.size() - 1;
         }
+        sortIconList();
+        endResetModel();
+        pruneThumbnails();
     }
 
-    sortIconList();
+    QStringList watched;
+    for (auto& [key, file] : added) {
+        watched.append(file);
+        emit iconUpdated(key);
+    }
+    if (!watched.isEmpty())
+        m_watcher->addPaths(watched);
 }
 
 void IconList::fileChanged(const QString& path)
@@ -175,15 +278,14 @@ void IconList::fileChanged(const QString& path)
     QFileInfo checkfile(path);
     if (!checkfile.exists())
         return;
-    QString key = checkfile.completeBaseName();
+    QString key = iconKeyForFile(checkfile);
     int idx = getIconIndex(key);
     if (idx == -1)
         return;
-    QIcon icon(path);
-    if (!icon.availableSizes().size())
-        return;
 
-    icons[idx].m_images[IconType::FileBased].icon = icon;
+    // drop the decoded icon, it is loaded again (with a new thumbnail) when it is next shown
+    dropThumbnail(path);
+    icons[idx].m_images[IconType::FileBased].icon = QIcon();
     dataChanged(index(idx), index(idx));
     emit iconUpdated(key);
 }
@@ -272,6 +374,7 @@ QVariant IconList::data(const QModelIndex& index, int role) const
 
     switch (role) {
         case Qt::DecorationRole:
+            ensureLoaded(row);
             return icons[row].icon();
         case Qt::DisplayRole:
             return icons[row].name();
@@ -317,6 +420,7 @@ const MMCIcon* IconList::icon(const QString& key) const
     int iconIdx = getIconIndex(key);
     if (iconIdx == -1)
         return nullptr;
+    ensureLoaded(iconIdx);
     return &icons[iconIdx];
 }
 
@@ -332,22 +436,22 @@ bool IconList::trashIcon(const QString& key)
 
 bool IconList::addThemeIcon(const QString& key)
 {
-    auto iter = name_index.find(key);
-    if (iter != name_index.end()) {
-        auto& oldOne = icons[*iter];
+    if (int existing = sortedIndexOf(key); existing != -1) {
+        auto& oldOne = icons[existing];
         oldOne.replace(Builtin, key);
-        dataChanged(index(*iter), index(*iter));
+        dataChanged(index(existing), index(existing));
         return true;
     }
     // add a new icon
-    beginInsertRows(QModelIndex(), icons.size(), icons.size());
+    int pos = insertPosition(key);
+    beginInsertRows(QModelIndex(), pos, pos);
     {
         MMCIcon mmc_icon;
         mmc_icon.m_name = key;
         mmc_icon.m_key = key;
         mmc_icon.replace(Builtin, key);
-        icons.push_back(mmc_icon);
-        name_index[key] = icons.size() - 1;
+        icons.insert(pos, mmc_icon);
+        m_indexDirty = true;
     }
     endInsertRows();
     return true;
@@ -356,25 +460,32 @@ bool IconList::addThemeIcon(const QString& key)
 bool IconList::addIcon(const QString& key, const QString& name, const QString& path, const IconType type)
 {
     // replace the icon even? is the input valid?
-    QIcon icon(path);
-    if (icon.isNull())
-        return false;
-    auto iter = name_index.find(key);
-    if (iter != name_index.end()) {
-        auto& oldOne = icons[*iter];
+    QIcon icon;
+    if (type == IconType::FileBased) {
+        // file based icons are decoded lazily, only check that this is an image
+        if (!QFileInfo(path).isFile() || QImageReader::imageFormat(path).isEmpty())
+            return false;
+    } else {
+        icon = QIcon(path);
+        if (icon.isNull())
+            return false;
+    }
+    if (int existing = sortedIndexOf(key); existing != -1) {
+        auto& oldOne = icons[existing];
         oldOne.replace(type, icon, path);
-        dataChanged(index(*iter), index(*iter));
+        dataChanged(index(existing), index(existing));
         return true;
     }
     // add a new icon
-    beginInsertRows(QModelIndex(), icons.size(), icons.size());
+    int pos = insertPosition(key);
+    beginInsertRows(QModelIndex(), pos, pos);
     {
         MMCIcon mmc_icon;
         mmc_icon.m_name = name;
         mmc_icon.m_key = key;
         mmc_icon.replace(type, icon, path);
-        icons.push_back(mmc_icon);
-        name_index[key] = icons.size() - 1;
+        icons.insert(pos, mmc_icon);
+        m_indexDirty = true;
     }
     endInsertRows();
     return true;
@@ -387,7 +498,7 @@ void IconList::saveIcon(const QString& key, const QString& path, const char* for
     pixmap.save(path, format);
 }
 
-void IconList::reindex()
+void IconList::reindex() const
 {
     name_index.clear();
     int i = 0;
@@ -395,25 +506,128 @@ void IconList::reindex()
         name_index[iter.m_key] = i;
         i++;
     }
+    m_indexDirty = false;
+}
+
+void IconList::ensureIndexed() const
+{
+    if (m_indexDirty)
+        reindex();
+}
+
+int IconList::sortedIndexOf(const QString& key) const
+{
+    for (int i = insertPosition(key); i < icons.size() && icons[i].m_key.localeAwareCompare(key) == 0; i++) {
+        if (icons[i].m_key == key)
+            return i;
+    }
+    return -1;
+}
+
+int IconList::insertPosition(const QString& key) const
+{
+    auto it = std::lower_bound(icons.begin(), icons.end(), key,
+                               [](const MMCIcon& icon, const QString& k) { return icon.m_key.localeAwareCompare(k) < 0; });
+    return it - icons.begin();
+}
+
+void IconList::ensureLoaded(int idx) const
+{
+    auto& image = icons[idx].m_images[IconType::FileBased];
+    if (!image.icon.isNull() || image.filename.isEmpty())
+        return;
+    image.icon = loadFileIcon(image.filename);
+}
+
+QIcon IconList::loadFileIcon(const QString& path) const
+{
+    QIcon icon;
+    // vector icons get nothing from a raster thumbnail
+    if (!m_thumbnailDir.isEmpty() && QFileInfo(path).suffix().compare("svg", Qt::CaseInsensitive) != 0) {
+        if (auto thumbnail = m_thumbnails.constFind(path); thumbnail != m_thumbnails.constEnd()) {
+            // QIcon picks the smallest image that is large enough, so the original is only decoded for large sizes
+            if (!thumbnail->isEmpty())
+                icon.addFile(*thumbnail);
+        } else if (!m_pendingThumbnails.contains(path)) {
+            // hashing and scaling the file is left to the thread pool, the icon gets the thumbnail once it is there
+            m_pendingThumbnails.insert(path);
+            QPointer<IconList> self(const_cast<IconList*>(this));
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, path, thumbnailDir = m_thumbnailDir] {
+                auto thumbnailPath = findThumbnail(path, thumbnailDir);
+                // queued calls are dropped with their context, so the list is still there when this runs
+                if (auto list = self.data())
+                    QMetaObject::invokeMethod(
+                        list, [list, path, thumbnailPath] { list->thumbnailReady(path, thumbnailPath); }, Qt::QueuedConnection);
+            });
+        }
+    }
+    icon.addFile(path);
+    return icon;
+}
+
+void IconList::dropThumbnail(const QString& path)
+{
+    auto thumbnailPath = m_thumbnails.take(path);
+    // identical icon files share their thumbnail
+    if (thumbnailPath.isEmpty() || !m_thumbnails.key(thumbnailPath).isEmpty())
+        return;
+    QFile::remove(thumbnailPath);
+}
+
+void IconList::pruneThumbnails() const
+{
+    if (m_thumbnailDir.isEmpty())
+        return;
+    QStringList iconFiles;
+    for (auto& icon : icons) {
+        if (icon.has(IconType::FileBased))
+            iconFiles.append(icon.m_images[IconType::FileBased].filename);
+    }
+    // hashing every icon is left to the thread pool, like the thumbnails themselves
+    QtConcurrent::run(QThreadPool::globalInstance(), [iconFiles, thumbnailDir = m_thumbnailDir, started = QDateTime::currentDateTime()] {
+        sweepThumbnails(iconFiles, thumbnailDir, started);
+    });
+}
+
+void IconList::thumbnailReady(const QString& path, const QString& thumbnailPath)
+{
+    m_pendingThumbnails.remove(path);
+    m_thumbnails.insert(path, thumbnailPath);
+    if (thumbnailPath.isEmpty())
+        return;
+
+    // the icon was built without the thumbnail, build it again when it is next shown
+    QString key = iconKeyForFile(QFileInfo(path));
+    int idx = getIconIndex(key);
+    if (idx == -1 || icons[idx].m_images[IconType::FileBased].filename != path)
+        return;
+    icons[idx].m_images[IconType::FileBased].icon = QIcon();
+    dataChanged(index(idx), index(idx));
+    emit iconUpdated(key);
 }
 
 QIcon IconList::getIcon(const QString& key) const
 {
     int icon_index = getIconIndex(key);
 
-    if (icon_index != -1)
+    if (icon_index != -1) {
+        ensureLoaded(icon_index);
         return icons[icon_index].icon();
+    }
 
     // Fallback for icons that don't exist.
     icon_index = getIconIndex("grass");
 
-    if (icon_index != -1)
+    if (icon_index != -1) {
+        ensureLoaded(icon_index);
         return icons[icon_index].icon();
+    }
     return QIcon();
 }
 
 int IconList::getIconIndex(const QString& key) const
 {
+    ensureIndexed();
     auto iter = name_index.find(key == "default" ? "grass" : key);
     if (iter != name_index.end())
         return *iter;
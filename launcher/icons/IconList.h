@@ -37,7 +37,9 @@
 #include <QAbstractListModel>
 #include <QDir>
 #include <QFile>
+#include <QHash>
 #include <QMutex>
+#include <QSet>
 #include <QtGui/QIcon>
 #include <memory>
 
@@ -51,7 +53,8 @@ class QFileSystemWatcher;
 class IconList : public QAbstractListModel {
     Q_OBJECT
    public:
-    explicit IconList(const QStringList& builtinPaths, QString path, QObject* parent = 0);
+    /// thumbnailPath is where downscaled copies of large user icons are cached, leave it empty to disable that cache
+    explicit IconList(const QStringList& builtinPaths, QString path, QString thumbnailPath = {}, QObject* parent = 0);
     virtual ~IconList() {};
 
     QIcon getIcon(const QString& key) const;
@@ -89,8 +92,20 @@ class IconList : public QAbstractListModel {
     IconList(const IconList&) = delete;
     // hide assign op
     IconList& operator=(const IconList&) = delete;
-    void reindex();
+    void reindex() const;
+    /// rebuilds the key index if icons were inserted since it was last built
+    void ensureIndexed() const;
+    /// finds an icon by binary search, without needing the key index
+    int sortedIndexOf(const QString& key) const;
     void sortIconList();
+    int insertPosition(const QString& key) const;
+    void ensureLoaded(int idx) const;
+    QIcon loadFileIcon(const QString& path) const;
+    void thumbnailReady(const QString& path, const QString& thumbnailPath);
+    /// forgets the thumbnail of a removed or changed icon file, and deletes it if no other icon uses it
+    void dropThumbnail(const QString& path);
+    /// deletes the cached thumbnails that no longer match any icon
+    void pruneThumbnails() const;
 
    public slots:
     void directoryChanged(const QString& path);
@@ -102,7 +117,15 @@ class IconList : public QAbstractListModel {
    private:
     shared_qobject_ptr<QFileSystemWatcher> m_watcher;
     bool is_watching;
-    QMap<QString, int> name_index;
-    QVector<MMCIcon> icons;
+    // rebuilt lazily, so a batch of insertions only reindexes once
+    mutable QMap<QString, int> name_index;
+    mutable bool m_indexDirty = false;
+    // mutable because file based icons are decoded on first access
+    mutable QVector<MMCIcon> icons;
     QDir m_dir;
+    QString m_thumbnailDir;
+    /// icon files whose thumbnail is being looked up or written
+    mutable QSet<QString> m_pendingThumbnails;
+    /// thumbnail of each icon file that was looked up, empty for icons that don't get one
+    QHash<QString, QString> m_thumbnails;
 };
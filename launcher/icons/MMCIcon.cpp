@@ -81,6 +81,8 @@ QIcon MMCIcon::icon() const
     auto& icon = m_images[m_current_type].icon;
     if (!icon.isNull())
         return icon;
+    if (!m_images[m_current_type].filename.isEmpty())
+        return QIcon(m_images[m_current_type].filename);
     // FIXME: inject this.
     return QIcon::fromTheme(m_images[m_current_type].key);
 }
@@ -40,10 +40,11 @@
 enum IconType : unsigned { Builtin, Transient, FileBased, ICONS_TOTAL, ToBeDeleted };
 
 struct MMCImage {
+    // file based images are only decoded when first used, until then only the filename is set
     QIcon icon;
     QString key;
     QString filename;
-    bool present() const { return !icon.isNull() || !key.isEmpty(); }
+    bool present() const { return !icon.isNull() || !key.isEmpty() || !filename.isEmpty(); }
 };
 
 struct MMCIcon {
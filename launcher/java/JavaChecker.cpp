@@ -40,16 +40,33 @@
 #include <QMap>
 #include <QProcess>
 
+#include "Application.h"
 #include "Commandline.h"
 #include "FileSystem.h"
+#include "java/JavaProbeCache.h"
 #include "java/JavaUtils.h"
 
 JavaChecker::JavaChecker(QString path, QString args, int minMem, int maxMem, int permGen, int id, QObject* parent)
     : Task(parent), m_path(path), m_args(args), m_minMem(minMem), m_maxMem(maxMem), m_permGen(permGen), m_id(id)
 {}
 
+bool JavaChecker::isPlainProbe() const
+{
+    return m_args.isEmpty() && m_minMem == 0 && m_maxMem == 0 && (m_permGen == 0 || m_permGen == 64);
+}
+
 void JavaChecker::executeTask()
 {
+    if (isPlainProbe()) {
+        if (auto cached = APPLICATION->javaProbeCache()->lookup(m_path)) {
+            qDebug() << "Using cached java checker result for" << m_path;
+            cached->id = m_id;
+            emit checkFinished(*cached);
+            emitSucceeded();
+            return;
+        }
+    }
+
     QString checkerJar = JavaUtils::getJavaCheckPath();
 
     if (checkerJar.isEmpty()) {
@@ -180,6 +197,8 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
     result.javaVersion = java_version;
     result.javaVendor = java_vendor;
     qDebug() << "Java checker succeeded.";
+    if (isPlainProbe())
+        APPLICATION->javaProbeCache()->store(result);
     emit checkFinished(result);
     emitSucceeded();
 }
@@ -34,6 +34,10 @@ class JavaChecker : public Task {
    protected:
     virtual void executeTask() override;
 
+   private:
+    /// whether this check only probes the binary, so its result can be shared through the JavaProbeCache
+    bool isPlainProbe() const;
+
    private:
     QProcessPtr process;
     QTimer killTimer;
@@ -38,11 +38,14 @@
 #include <QtXml>
 
 #include <QDebug>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
 #include <algorithm>
 
 #include "Application.h"
 #include "java/JavaChecker.h"
 #include "java/JavaInstallList.h"
+#include "java/JavaProbeCache.h"
 #include "java/JavaUtils.h"
 #include "tasks/ConcurrentTask.h"
 
@@ -150,6 +153,32 @@ void JavaInstallList::sortVersions()
     endResetModel();
 }
 
+void JavaInstallList::addJava(JavaInstallPtr java)
+{
+    // when reloading, the previous list stays until updateListData replaces it
+    for (auto& existing : m_vlist) {
+        if (std::dynamic_pointer_cast<JavaInstall>(existing)->path == java->path)
+            return;
+    }
+    BaseVersion::Ptr version = java;
+    // keep the order the finished list will have, so entries don't jump around once loading is done
+    auto it = std::upper_bound(m_vlist.begin(), m_vlist.end(), version, sortJavas);
+    auto row = static_cast<int>(std::distance(m_vlist.begin(), it));
+    beginInsertRows(QModelIndex(), row, row);
+    m_vlist.insert(row, version);
+    endInsertRows();
+}
+
+static JavaInstallPtr makeJavaInstall(const JavaChecker::Result& result)
+{
+    JavaInstallPtr javaVersion(new JavaInstall());
+    javaVersion->id = result.javaVersion;
+    javaVersion->arch = result.realPlatform;
+    javaVersion->path = result.path;
+    javaVersion->is_64bit = result.is_64bit;
+    return javaVersion;
+}
+
 JavaListLoadTask::JavaListLoadTask(JavaInstallList* vlist, bool onlyManagedVersions) : Task(), m_only_managed_versions(onlyManagedVersions)
 {
     m_list = vlist;
@@ -160,26 +189,81 @@ void JavaListLoadTask::executeTask()
 {
     setStatus(tr("Detecting Java installations..."));
 
-    JavaUtils ju;
-    QList<QString> candidate_paths = m_only_managed_versions ? getPrismJavaBundle() : ju.FindJavaPaths();
-
-    ConcurrentTask::Ptr job(new ConcurrentTask(this, "Java detection", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
-    m_job.reset(job);
+    m_job.reset(new ConcurrentTask(this, "Java detection", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
     connect(m_job.get(), &Task::finished, this, &JavaListLoadTask::javaCheckerFinished);
     connect(m_job.get(), &Task::progress, this, &Task::setProgress);
 
-    qDebug() << "Probing the following Java paths: ";
-    int id = 0;
-    for (QString candidate : candidate_paths) {
-        auto checker = new JavaChecker(candidate, "", 0, 0, 0, id, this);
-        connect(checker, &JavaChecker::checkFinished, [this](const JavaChecker::Result& result) { m_results << result; });
-        job->addTask(Task::Ptr(checker));
-        id++;
+    if (m_only_managed_versions) {
+        addCandidates(getPrismJavaBundle());
+        startProbing();
+        return;
+    }
+
+    JavaUtils ju;
+    addCandidates(ju.FindFixedJavaPaths());
+
+    // the search roots that did not change since they were last scanned don't need to be listed again
+    auto probeCache = APPLICATION->javaProbeCache();
+    QList<JavaSearchRoot> stale;
+    for (auto& root : JavaUtils::javaSearchRoots()) {
+        if (auto cached = probeCache->lookupRoot(root.path))
+            addCandidates(*cached);
+        else
+            stale.append(root);
+    }
+    if (stale.isEmpty()) {
+        startProbing();
+        return;
     }
 
+    // the others are listed in parallel, and their javas are added as soon as each of them is done
+    auto watcher = new QFutureWatcher<JavaSearchRoot::Scan>(this);
+    connect(watcher, &QFutureWatcher<JavaSearchRoot::Scan>::resultReadyAt, this, [this, watcher, stale](int index) {
+        auto scan = watcher->resultAt(index);
+        APPLICATION->javaProbeCache()->storeRoot(stale[index].path, scan.lastModified, scan.javas);
+        addCandidates(scan.javas);
+    });
+    connect(watcher, &QFutureWatcher<JavaSearchRoot::Scan>::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        startProbing();
+    });
+    watcher->setFuture(QtConcurrent::mapped(stale, &JavaUtils::scanJavaSearchRoot));
+}
+
+void JavaListLoadTask::startProbing()
+{
+    // the checkers only start once every candidate is known, the job would finish early if its queue ran dry in between
     m_job->start();
 }
 
+void JavaListLoadTask::addCandidates(const QStringList& paths)
+{
+    auto probeCache = APPLICATION->javaProbeCache();
+    for (const QString& candidate : paths) {
+        if (m_candidates.contains(candidate))
+            continue;
+        m_candidates.insert(candidate);
+        int id = m_candidates.size() - 1;
+
+        // only spawn a JVM for runtimes that are new or changed since they were last probed
+        if (auto cached = probeCache->lookup(candidate)) {
+            cached->id = id;
+            addResult(*cached);
+            continue;
+        }
+        auto checker = new JavaChecker(candidate, "", 0, 0, 0, id, this);
+        connect(checker, &JavaChecker::checkFinished, this, &JavaListLoadTask::addResult);
+        m_job->addTask(Task::Ptr(checker));
+    }
+}
+
+void JavaListLoadTask::addResult(const JavaChecker::Result& result)
+{
+    m_results << result;
+    if (result.validity == JavaChecker::Result::Validity::Valid)
+        m_list->addJava(makeJavaInstall(result));
+}
+
 void JavaListLoadTask::javaCheckerFinished()
 {
     QList<JavaInstallPtr> candidates;
@@ -188,12 +272,7 @@ void JavaListLoadTask::javaCheckerFinished()
     qDebug() << "Found the following valid Java installations:";
     for (auto result : m_results) {
         if (result.validity == JavaChecker::Result::Validity::Valid) {
-            JavaInstallPtr javaVersion(new JavaInstall());
-
-            javaVersion->id = result.javaVersion;
-            javaVersion->arch = result.realPlatform;
-            javaVersion->path = result.path;
-            javaVersion->is_64bit = result.is_64bit;
+            auto javaVersion = makeJavaInstall(result);
             candidates.append(javaVersion);
 
             qDebug() << " " << javaVersion->id.toString() << javaVersion->arch << javaVersion->path;
@@ -17,9 +17,11 @@
 
 #include <QAbstractListModel>
 #include <QObject>
+#include <QSet>
 
 #include "BaseVersionList.h"
 #include "java/JavaChecker.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/Task.h"
 
 #include "JavaInstall.h"
@@ -44,6 +46,9 @@ class JavaInstallList : public BaseVersionList {
     QVariant data(const QModelIndex& index, int role) const override;
     RoleList providesRoles() const override;
 
+    /// shows a java that was found while the list is still loading
+    void addJava(JavaInstallPtr java);
+
    public slots:
     void updateListData(QList<BaseVersion::Ptr> versions) override;
 
@@ -71,7 +76,14 @@ class JavaListLoadTask : public Task {
     void javaCheckerFinished();
 
    protected:
-    Task::Ptr m_job;
+    /// probes the java binaries that were not seen yet, cached probes are added right away
+    void addCandidates(const QStringList& paths);
+    void addResult(const JavaChecker::Result& result);
+    void startProbing();
+
+   protected:
+    ConcurrentTask::Ptr m_job;
+    QSet<QString> m_candidates;
     JavaInstallList* m_list;
     JavaInstall* m_current_recommended;
     QList<JavaChecker::Result> m_results;
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JavaProbeCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+#include "Json.h"
+
+JavaProbeCache::JavaProbeCache(QString path) : QObject(), m_index_file(path)
+{
+    m_saveBatchingTimer.setSingleShot(true);
+    m_saveBatchingTimer.setTimerType(Qt::VeryCoarseTimer);
+
+    connect(&m_saveBatchingTimer, &QTimer::timeout, this, &JavaProbeCache::SaveNow);
+}
+
+JavaProbeCache::~JavaProbeCache()
+{
+    if (m_saveBatchingTimer.isActive()) {
+        m_saveBatchingTimer.stop();
+        SaveNow();
+    }
+}
+
+QString JavaProbeCache::canonicalKey(const QString& javaPath)
+{
+    // resolves symlinks, so /usr/bin/java and the alternatives target share one entry
+    return QFileInfo(javaPath).canonicalFilePath();
+}
+
+std::optional<JavaChecker::Result> JavaProbeCache::lookup(const QString& javaPath)
+{
+    auto key = canonicalKey(javaPath);
+    if (key.isEmpty())
+        return {};
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+
+    QFileInfo info(key);
+    if (!info.isFile() || info.size() != it->size || info.lastModified().toMSecsSinceEpoch() != it->lastModified) {
+        // the runtime was changed or replaced, it needs to be probed again
+        m_entries.erase(it);
+        SaveEventually();
+        return {};
+    }
+
+    auto result = it->result;
+    result.path = javaPath;
+    return result;
+}
+
+void JavaProbeCache::store(const JavaChecker::Result& result)
+{
+    if (result.validity != JavaChecker::Result::Validity::Valid)
+        return;
+
+    auto key = canonicalKey(result.path);
+    if (key.isEmpty())
+        return;
+
+    QFileInfo info(key);
+    Entry entry;
+    entry.size = info.size();
+    entry.lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry.result = result;
+    // logs are only meaningful for the run that produced them
+    entry.result.outLog.clear();
+    entry.result.errorLog.clear();
+    m_entries.insert(key, entry);
+    SaveEventually();
+}
+
+std::optional<QStringList> JavaProbeCache::lookupRoot(const QString& rootPath)
+{
+    QFileInfo info(rootPath);
+    // a missing root has no runtimes in it, that is as cheap to find out as checking it
+    if (!info.isDir())
+        return QStringList();
+
+    auto it = m_roots.find(info.absoluteFilePath());
+    if (it == m_roots.end())
+        return {};
+
+    // adding or removing a runtime changes the modification time of the root
+    if (info.lastModified().toMSecsSinceEpoch() != it->lastModified) {
+        m_roots.erase(it);
+        SaveEventually();
+        return {};
+    }
+    return it->javas;
+}
+
+void JavaProbeCache::storeRoot(const QString& rootPath, qint64 lastModified, const QStringList& javas)
+{
+    if (lastModified == 0)
+        return;
+
+    RootEntry entry;
+    entry.lastModified = lastModified;
+    entry.javas = javas;
+    m_roots.insert(QFileInfo(rootPath).absoluteFilePath(), entry);
+    SaveEventually();
+}
+
+void JavaProbeCache::clear()
+{
+    m_entries.clear();
+    m_roots.clear();
+    SaveEventually();
+}
+
+void JavaProbeCache::Load()
+{
+    if (m_index_file.isNull())
+        return;
+
+    QFile index(m_index_file);
+    if (!index.open(QIODevice::ReadOnly))
+        return;
+
+    QJsonParseError parseError;
+    QJsonDocument json = QJsonDocument::fromJson(index.readAll(), &parseError);
+
+    if (parseError.error != QJsonParseError::NoError || !json.isObject()) {
+        qWarning() << "Failed to parse java probe cache file:" << parseError.errorString();
+        return;
+    }
+
+    auto root = json.object();
+    if (Json::ensureString(root, "version") != "1")
+        return;
+
+    for (auto element : Json::ensureArray(root, "entries")) {
+        auto obj = Json::ensureObject(element);
+        auto key = Json::ensureString(obj, "path");
+        if (key.isEmpty())
+            continue;
+
+        Entry entry;
+        entry.size = Json::ensureDouble(obj, "size");
+        entry.lastModified = Json::ensureDouble(obj, "last_modified");
+        entry.result.path = key;
+        entry.result.javaVersion = Json::ensureString(obj, "java_version");
+        entry.result.javaVendor = Json::ensureString(obj, "java_vendor");
+        entry.result.realPlatform = Json::ensureString(obj, "os_arch");
+        entry.result.is_64bit = Json::ensureBoolean(obj, QStringLiteral("is_64bit"), false);
+        entry.result.mojangPlatform = entry.result.is_64bit ? "64" : "32";
+        entry.result.validity = JavaChecker::Result::Validity::Valid;
+        m_entries.insert(key, entry);
+    }
+
+    for (auto element : Json::ensureArray(root, "roots")) {
+        auto obj = Json::ensureObject(element);
+        auto key = Json::ensureString(obj, "path");
+        if (key.isEmpty())
+            continue;
+
+        RootEntry entry;
+        entry.lastModified = Json::ensureDouble(obj, "last_modified");
+        for (auto java : Json::ensureArray(obj, "javas"))
+            entry.javas.append(java.toString());
+        m_roots.insert(key, entry);
+    }
+}
+
+void JavaProbeCache::SaveEventually()
+{
+    // reset the save timer
+    m_saveBatchingTimer.stop();
+    m_saveBatchingTimer.start(5000);
+}
+
+void JavaProbeCache::SaveNow()
+{
+    if (m_index_file.isNull())
+        return;
+
+    QJsonObject toplevel;
+    Json::writeString(toplevel, "version", "1");
+
+    QJsonArray entriesArr;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        QJsonObject entryObj;
+        Json::writeString(entryObj, "path", it.key());
+        entryObj.insert("size", QJsonValue(double(it->size)));
+        entryObj.insert("last_modified", QJsonValue(double(it->lastModified)));
+        Json::writeString(entryObj, "java_version", it->result.javaVersion.toString());
+        Json::writeString(entryObj, "java_vendor", it->result.javaVendor);
+        Json::writeString(entryObj, "os_arch", it->result.realPlatform);
+        entryObj.insert("is_64bit", it->result.is_64bit);
+        entriesArr.append(entryObj);
+    }
+    toplevel.insert("entries", entriesArr);
+
+    QJsonArray rootsArr;
+    for (auto it = m_roots.cbegin(); it != m_roots.cend(); ++it) {
+        QJsonObject rootObj;
+        Json::writeString(rootObj, "path", it.key());
+        rootObj.insert("last_modified", QJsonValue(double(it->lastModified)));
+        rootObj.insert("javas", QJsonArray::fromStringList(it->javas));
+        rootsArr.append(rootObj);
+    }
+    toplevel.insert("roots", rootsArr);
+
+    try {
+        Json::write(toplevel, m_index_file);
+    } catch (const Exception& e) {
+        qWarning() << "Error writing java probe cache:" << e.what();
+    }
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <optional>
+
+#include "java/JavaChecker.h"
+
+/**
+ * Persistent database of java checker results.
+ *
+ * Entries are keyed by the canonical path of the java binary and are only considered valid
+ * while the size and modification time of that binary match the ones recorded at probe time.
+ * Only plain probes (no extra arguments or memory settings) are stored.
+ *
+ * It also remembers which java binaries were found in each search root, for as long as the
+ * modification time of the root stays the same.
+ */
+class JavaProbeCache : public QObject {
+    Q_OBJECT
+   public:
+    // supply path to the cache index file
+    explicit JavaProbeCache(QString path = QString());
+    ~JavaProbeCache() override;
+
+    /// returns the cached result for the given java binary, if it is still valid
+    std::optional<JavaChecker::Result> lookup(const QString& javaPath);
+
+    /// remembers a successful probe of the given java binary
+    void store(const JavaChecker::Result& result);
+
+    /// returns the java binaries found in the search root when it was last scanned, if it has not changed since
+    std::optional<QStringList> lookupRoot(const QString& rootPath);
+
+    /// remembers the java binaries found in a search root, as it was at the given modification time
+    void storeRoot(const QString& rootPath, qint64 lastModified, const QStringList& javas);
+
+    /// drops every cached result
+    void clear();
+
+    // (re)start a timer that calls SaveNow later.
+    void SaveEventually();
+    void Load();
+
+   public slots:
+    void SaveNow();
+
+   private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 lastModified = 0;
+        JavaChecker::Result result;
+    };
+
+    struct RootEntry {
+        qint64 lastModified = 0;
+        QStringList javas;
+    };
+
+    static QString canonicalKey(const QString& javaPath);
+
+    QHash<QString, Entry> m_entries;
+    QHash<QString, RootEntry> m_roots;
+    QString m_index_file;
+    QTimer m_saveBatchingTimer;
+};
@@ -33,6 +33,7 @@
  *      limitations under the License.
  */
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QString>
@@ -239,7 +240,7 @@ QList<JavaInstallPtr> JavaUtils::FindJavaFromRegistryKey(DWORD keyType, QString
     return javas;
 }
 
-QList<QString> JavaUtils::FindJavaPaths()
+QList<QString> JavaUtils::FindFixedJavaPaths()
 {
     QList<JavaInstallPtr> java_candidates;
 
@@ -353,43 +354,48 @@ QList<QString> JavaUtils::FindJavaPaths()
     return candidates;
 }
 
+QList<JavaSearchRoot> JavaUtils::javaSearchRoots()
+{
+    // runtimes are found through the registry instead
+    return {};
+}
+
 #elif defined(Q_OS_MAC)
-QList<QString> JavaUtils::FindJavaPaths()
+QList<QString> JavaUtils::FindFixedJavaPaths()
 {
     QList<QString> javas;
     javas.append(this->GetDefaultJava()->path);
     javas.append("/Applications/Xcode.app/Contents/Applications/Application Loader.app/Contents/MacOS/itms/java/bin/java");
     javas.append("/Library/Internet Plug-Ins/JavaAppletPlugin.plugin/Contents/Home/bin/java");
     javas.append("/System/Library/Frameworks/JavaVM.framework/Versions/Current/Commands/java");
-    QDir libraryJVMDir("/Library/Java/JavaVirtualMachines/");
-    QStringList libraryJVMJavas = libraryJVMDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, libraryJVMJavas) {
-        javas.append(libraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/bin/java");
-        javas.append(libraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/jre/bin/java");
-    }
-    QDir systemLibraryJVMDir("/System/Library/Java/JavaVirtualMachines/");
-    QStringList systemLibraryJVMJavas = systemLibraryJVMDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, systemLibraryJVMJavas) {
-        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/bin/java");
-        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Commands/java");
-    }
+
+    javas.append(getMinecraftJavaBundle());
+    javas.append(getPrismJavaBundle());
+    javas = addJavasFromEnv(javas);
+    javas.removeDuplicates();
+    return javas;
+}
+
+QList<JavaSearchRoot> JavaUtils::javaSearchRoots()
+{
+    QList<JavaSearchRoot> roots;
+    roots.append({ "/Library/Java/JavaVirtualMachines", { "Contents/Home/bin/java", "Contents/Home/jre/bin/java" } });
+    roots.append({ "/System/Library/Java/JavaVirtualMachines", { "Contents/Home/bin/java", "Contents/Commands/java" } });
 
     auto home = qEnvironmentVariable("HOME");
 
     // javas downloaded by sdkman
-    QDir sdkmanDir(FS::PathCombine(home, ".sdkman/candidates/java"));
-    QStringList sdkmanJavas = sdkmanDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, sdkmanJavas) {
-        javas.append(sdkmanDir.absolutePath() + "/" + java + "/bin/java");
-    }
-
+    roots.append({ FS::PathCombine(home, ".sdkman/candidates/java"), { "bin/java" } });
     // java in user library folder (like from intellij downloads)
-    QDir userLibraryJVMDir(FS::PathCombine(home, "Library/Java/JavaVirtualMachines/"));
-    QStringList userLibraryJVMJavas = userLibraryJVMDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, userLibraryJVMJavas) {
-        javas.append(userLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/bin/java");
-        javas.append(userLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Commands/java");
-    }
+    roots.append({ FS::PathCombine(home, "Library/Java/JavaVirtualMachines"), { "Contents/Home/bin/java", "Contents/Commands/java" } });
+    return roots;
+}
+
+#elif defined(Q_OS_LINUX) || defined(Q_OS_OPENBSD) || defined(Q_OS_FREEBSD)
+QList<QString> JavaUtils::FindFixedJavaPaths()
+{
+    QList<QString> javas;
+    javas.append(this->GetDefaultJava()->path);
 
     javas.append(getMinecraftJavaBundle());
     javas.append(getPrismJavaBundle());
@@ -398,80 +404,59 @@ QList<QString> JavaUtils::FindJavaPaths()
     return javas;
 }
 
-#elif defined(Q_OS_LINUX) || defined(Q_OS_OPENBSD) || defined(Q_OS_FREEBSD)
-QList<QString> JavaUtils::FindJavaPaths()
+QList<JavaSearchRoot> JavaUtils::javaSearchRoots()
 {
-    QList<QString> javas;
-    javas.append(this->GetDefaultJava()->path);
-    auto scanJavaDir = [&](
-                           const QString& dirPath,
-                           const std::function<bool(const QFileInfo&)>& filter = [](const QFileInfo&) { return true; }) {
-        QDir dir(dirPath);
-        if (!dir.exists())
-            return;
-        auto entries = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (auto& entry : entries) {
-            if (!filter(entry))
-                continue;
-
-            QString prefix;
-            prefix = entry.canonicalFilePath();
-            javas.append(FS::PathCombine(prefix, "jre/bin/java"));
-            javas.append(FS::PathCombine(prefix, "bin/java"));
-        }
+    QList<JavaSearchRoot> roots;
+    auto addRoot = [&roots](const QString& dirPath, const std::function<bool(const QFileInfo&)>& filter = {}) {
+        roots.append({ dirPath, { "jre/bin/java", "bin/java" }, filter });
     };
     // java installed in a snap is installed in the standard directory, but underneath $SNAP
     auto snap = qEnvironmentVariable("SNAP");
-    auto scanJavaDirs = [&](const QString& dirPath) {
-        scanJavaDir(dirPath);
+    auto addRoots = [&](const QString& dirPath) {
+        addRoot(dirPath);
         if (!snap.isNull()) {
-            scanJavaDir(snap + dirPath);
+            addRoot(snap + dirPath);
         }
     };
 #if defined(Q_OS_LINUX)
     // oracle RPMs
-    scanJavaDirs("/usr/java");
+    addRoots("/usr/java");
     // general locations used by distro packaging
-    scanJavaDirs("/usr/lib/jvm");
-    scanJavaDirs("/usr/lib64/jvm");
-    scanJavaDirs("/usr/lib32/jvm");
+    addRoots("/usr/lib/jvm");
+    addRoots("/usr/lib64/jvm");
+    addRoots("/usr/lib32/jvm");
     // Gentoo's locations for openjdk and openjdk-bin respectively
     auto gentooFilter = [](const QFileInfo& info) {
         QString fileName = info.fileName();
         return fileName.startsWith("openjdk-") || fileName.startsWith("openj9-");
     };
-    scanJavaDir("/usr/lib64", gentooFilter);
-    scanJavaDir("/usr/lib", gentooFilter);
-    scanJavaDir("/opt", gentooFilter);
+    addRoot("/usr/lib64", gentooFilter);
+    addRoot("/usr/lib", gentooFilter);
+    addRoot("/opt", gentooFilter);
     // javas stored in Prism Launcher's folder
-    scanJavaDirs("java");
+    addRoots("java");
     // manually installed JDKs in /opt
-    scanJavaDirs("/opt/jdk");
-    scanJavaDirs("/opt/jdks");
-    scanJavaDirs("/opt/ibm");  // IBM Semeru Certified Edition
+    addRoots("/opt/jdk");
+    addRoots("/opt/jdks");
+    addRoots("/opt/ibm");  // IBM Semeru Certified Edition
     // flatpak
-    scanJavaDirs("/app/jdk");
+    addRoots("/app/jdk");
 #elif defined(Q_OS_OPENBSD) || defined(Q_OS_FREEBSD)
     // ports install to /usr/local on OpenBSD & FreeBSD
-    scanJavaDirs("/usr/local");
+    addRoots("/usr/local");
 #endif
     auto home = qEnvironmentVariable("HOME");
 
     // javas downloaded by IntelliJ
-    scanJavaDirs(FS::PathCombine(home, ".jdks"));
+    addRoots(FS::PathCombine(home, ".jdks"));
     // javas downloaded by sdkman
-    scanJavaDirs(FS::PathCombine(home, ".sdkman/candidates/java"));
+    addRoots(FS::PathCombine(home, ".sdkman/candidates/java"));
     // javas downloaded by gradle (toolchains)
-    scanJavaDirs(FS::PathCombine(home, ".gradle/jdks"));
-
-    javas.append(getMinecraftJavaBundle());
-    javas.append(getPrismJavaBundle());
-    javas = addJavasFromEnv(javas);
-    javas.removeDuplicates();
-    return javas;
+    addRoots(FS::PathCombine(home, ".gradle/jdks"));
+    return roots;
 }
 #else
-QList<QString> JavaUtils::FindJavaPaths()
+QList<QString> JavaUtils::FindFixedJavaPaths()
 {
     qDebug() << "Unknown operating system build - defaulting to \"java\"";
 
@@ -483,8 +468,34 @@ QList<QString> JavaUtils::FindJavaPaths()
     javas.removeDuplicates();
     return addJavasFromEnv(javas);
 }
+
+QList<JavaSearchRoot> JavaUtils::javaSearchRoots()
+{
+    return {};
+}
 #endif
 
+JavaSearchRoot::Scan JavaUtils::scanJavaSearchRoot(const JavaSearchRoot& root)
+{
+    JavaSearchRoot::Scan scan;
+    QFileInfo rootInfo(root.path);
+    if (!rootInfo.isDir())
+        return scan;
+    // taken before listing the directory, so a change made while it is listed is noticed on the next scan
+    scan.lastModified = rootInfo.lastModified().toMSecsSinceEpoch();
+
+    auto entries = QDir(root.path).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (auto& entry : entries) {
+        if (root.filter && !root.filter(entry))
+            continue;
+
+        auto prefix = entry.canonicalFilePath();
+        for (auto& binary : root.binaries)
+            scan.javas.append(FS::PathCombine(prefix, binary));
+    }
+    return scan;
+}
+
 QString JavaUtils::getJavaCheckPath()
 {
     return APPLICATION->getJarPath("JavaCheck.jar");
@@ -15,8 +15,10 @@
 
 #pragma once
 
+#include <QFileInfo>
 #include <QProcess>
 #include <QStringList>
+#include <functional>
 #include "java/JavaInstall.h"
 
 #ifdef Q_OS_WIN
@@ -28,19 +30,38 @@ QProcessEnvironment CleanEnviroment();
 QStringList getMinecraftJavaBundle();
 QStringList getPrismJavaBundle();
 
+/// A directory that java runtimes are installed into, one runtime in each of its subdirectories
+struct JavaSearchRoot {
+    QString path;
+    /// where the java binary may be inside a runtime, relative to the runtime
+    QStringList binaries;
+    /// which subdirectories are runtimes, all of them if not set
+    std::function<bool(const QFileInfo&)> filter;
+
+    struct Scan {
+        qint64 lastModified = 0;
+        QStringList javas;
+    };
+};
+
 class JavaUtils : public QObject {
     Q_OBJECT
    public:
     JavaUtils();
 
     JavaInstallPtr MakeJavaPtr(QString path, QString id = "unknown", QString arch = "unknown");
-    QList<QString> FindJavaPaths();
+    /// java binaries in well-known places, without the runtimes in the search roots
+    QList<QString> FindFixedJavaPaths();
     JavaInstallPtr GetDefaultJava();
 
 #ifdef Q_OS_WIN
     QList<JavaInstallPtr> FindJavaFromRegistryKey(DWORD keyType, QString keyName, QString keyJavaDir, QString subkeySuffix = "");
 #endif
 
+    static QList<JavaSearchRoot> javaSearchRoots();
+    /// lists the java binaries of the runtimes in the root, safe to call from any thread
+    static JavaSearchRoot::Scan scanJavaSearchRoot(const JavaSearchRoot& root);
+
     static QString getJavaCheckPath();
     static const QString javaExecutable;
 };
@@ -43,9 +43,17 @@
 #include <QEventLoop>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include "Application.h"
+#include "FileSystem.h"
 #include "MessageLevel.h"
+#include "net/NetworkScheduler.h"
 #include "tasks/Task.h"
 
+static QString stepName(LaunchStep* step)
+{
+    return step->objectName().isEmpty() ? step->metaObject()->className() : step->objectName();
+}
+
 void LaunchTask::init()
 {
     m_instance->setRunning(true);
@@ -62,11 +70,25 @@ LaunchTask::LaunchTask(MinecraftInstancePtr instance) : m_instance(instance) {}
 
 void LaunchTask::appendStep(shared_qobject_ptr<LaunchStep> step)
 {
+    QList<LaunchStep*> dependencies;
+    for (auto& other : m_steps) {
+        dependencies.append(other.get());
+    }
+    appendStep(step, dependencies);
+}
+
+void LaunchTask::appendStep(shared_qobject_ptr<LaunchStep> step, const QList<LaunchStep*>& dependencies)
+{
+    m_dependencies.insert(step.get(), dependencies);
     m_steps.append(step);
 }
 
 void LaunchTask::prependStep(shared_qobject_ptr<LaunchStep> step)
 {
+    for (auto& other : m_steps) {
+        m_dependencies[other.get()].append(step.get());
+    }
+    m_dependencies.insert(step.get(), {});
     m_steps.prepend(step);
 }
 
@@ -76,59 +98,150 @@ void LaunchTask::executeTask()
     if (!m_steps.size()) {
         state = LaunchTask::Finished;
         emitSucceeded();
+        return;
     }
     state = LaunchTask::Running;
-    onStepFinished();
+    m_launchEvent = m_trace.begin("Launch", "launch");
+    startReadySteps();
+}
+
+void LaunchTask::startReadySteps()
+{
+    // go by index, steps that finish right away start the next ones from in here
+    for (int i = 0; i < m_steps.size() && !m_failing; i++) {
+        auto step = m_steps[i].get();
+        if (m_startedSteps.contains(step)) {
+            continue;
+        }
+        bool ready = true;
+        for (auto dependency : m_dependencies.value(step)) {
+            if (!dependency->wasSuccessful()) {
+                ready = false;
+                break;
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+        m_startedSteps.append(step);
+        m_runningSteps.insert(step);
+        m_stepEvents.insert(step, { m_trace.begin(stepName(step), "step"), Net::NetworkScheduler::instance()->bytesReceived() });
+        step->start();
+    }
 }
 
 void LaunchTask::onReadyForLaunch()
 {
+    if (!m_readyMarked) {
+        m_readyMarked = true;
+        m_trace.instant("Ready to launch", "launch");
+    }
+    queueRequest(qobject_cast<LaunchStep*>(sender()), false);
+}
+
+void LaunchTask::onProgressReportingRequested()
+{
+    queueRequest(qobject_cast<LaunchStep*>(sender()), true);
+}
+
+void LaunchTask::queueRequest(LaunchStep* step, bool progress)
+{
+    if (!step) {
+        return;
+    }
+    m_requests.append({ step, progress });
+    processNextRequest();
+}
+
+void LaunchTask::processNextRequest()
+{
+    if (m_activeRequest || m_requests.isEmpty() || state != LaunchTask::Running) {
+        return;
+    }
+    auto request = m_requests.takeFirst();
+    m_activeRequest = request.first;
     state = LaunchTask::Waiting;
-    emit readyForLaunch();
+    if (request.second) {
+        emit requestProgress(request.first);
+    } else {
+        emit readyForLaunch();
+    }
 }
 
 void LaunchTask::onStepFinished()
 {
-    // initial -> just start the first step
-    if (currentStep == -1) {
-        currentStep++;
-        m_steps[currentStep]->start();
+    auto step = qobject_cast<LaunchStep*>(sender());
+    if (!step || !m_runningSteps.remove(step)) {
         return;
     }
 
-    auto step = m_steps[currentStep];
-    if (step->wasSuccessful()) {
-        // end?
-        if (currentStep == m_steps.size() - 1) {
-            finalizeSteps(true, QString());
-        } else {
-            currentStep++;
-            step = m_steps[currentStep];
-            step->start();
+    // with steps running in parallel this counts everything received while the step was running
+    auto [event, bytesAtStart] = m_stepEvents.value(step, { -1, 0 });
+    m_trace.end(event, Net::NetworkScheduler::instance()->bytesReceived() - bytesAtStart);
+
+    for (auto it = m_requests.begin(); it != m_requests.end();) {
+        it = it->first == step ? m_requests.erase(it) : it + 1;
+    }
+    if (m_activeRequest == step) {
+        m_activeRequest = nullptr;
+        if (state == LaunchTask::Waiting) {
+            state = LaunchTask::Running;
+        }
+        // let whoever handled the request (e.g. a progress dialog) wrap up before asking again
+        QMetaObject::invokeMethod(this, &LaunchTask::processNextRequest, Qt::QueuedConnection);
+    }
+
+    advanceLog();
+
+    if (!step->wasSuccessful() && !m_failing) {
+        m_failing = true;
+        m_failReason = step->failReason();
+        // stop the steps that were running alongside the failed one
+        for (auto other : m_runningSteps.values()) {
+            if (other->canAbort()) {
+                other->abort();
+            }
         }
+    }
+
+    if (!m_failing) {
+        startReadySteps();
+    }
+
+    // aborting the other steps above may have wrapped things up already
+    if (!m_runningSteps.isEmpty() || m_finalized) {
+        return;
+    }
+    if (m_failing) {
+        finalizeSteps(false, m_failReason);
+    } else if (m_startedSteps.size() == m_steps.size()) {
+        finalizeSteps(true, QString());
     } else {
-        finalizeSteps(false, step->failReason());
+        finalizeSteps(false, tr("Some launch steps could not start because the steps they depend on are missing."));
     }
 }
 
 void LaunchTask::finalizeSteps(bool successful, const QString& error)
 {
-    for (auto step = currentStep; step >= 0; step--) {
-        m_steps[step]->finalize();
+    m_finalized = true;
+    advanceLog(true);
+    m_trace.end(m_launchEvent);
+    // the game has exited by now, so this has everything that was recorded
+    saveTrace();
+    for (auto it = m_startedSteps.crbegin(); it != m_startedSteps.crend(); it++) {
+        (*it)->finalize();
     }
     if (successful) {
+        state = LaunchTask::Finished;
         emitSucceeded();
     } else {
+        if (state != LaunchTask::Aborted) {
+            state = LaunchTask::Failed;
+        }
         emitFailed(error);
     }
 }
 
-void LaunchTask::onProgressReportingRequested()
-{
-    state = LaunchTask::Waiting;
-    emit requestProgress(m_steps[currentStep].get());
-}
-
 void LaunchTask::setCensorFilter(QMap<QString, QString> filter)
 {
     m_censorFilter = filter;
@@ -149,7 +262,28 @@ void LaunchTask::proceed()
     if (state != LaunchTask::Waiting) {
         return;
     }
-    m_steps[currentStep]->proceed();
+    if (m_activeRequest) {
+        state = LaunchTask::Running;
+        if (!m_launched) {
+            m_launched = true;
+            m_trace.instant("Game launched", "launch");
+            appendLogLine(tr("Launch timings:"), MessageLevel::Launcher);
+            for (auto& line : m_trace.summary()) {
+                appendLogLine("  " + line, MessageLevel::Launcher);
+            }
+        }
+        m_activeRequest->proceed();
+    }
+}
+
+void LaunchTask::saveTrace()
+{
+    if (!APPLICATION->saveTraces())
+        return;
+    auto path = FS::PathCombine("logs", QString("launch-%1.trace.json").arg(m_instance->id()));
+    if (m_trace.save(path)) {
+        qDebug() << "Launch timings of" << m_instance->id() << "written to" << path;
+    }
 }
 
 bool LaunchTask::canAbort() const
@@ -163,8 +297,12 @@ bool LaunchTask::canAbort() const
             return true;
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            return step->canAbort();
+            for (auto step : m_runningSteps) {
+                if (!step->canAbort()) {
+                    return false;
+                }
+            }
+            return true;
         }
     }
     return false;
@@ -184,14 +322,15 @@ bool LaunchTask::abort()
         }
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            if (!step->canAbort()) {
+            if (!canAbort()) {
                 return false;
             }
-            if (step->abort()) {
-                state = LaunchTask::Aborted;
-                return true;
+            state = LaunchTask::Aborted;
+            bool aborted = true;
+            for (auto step : m_runningSteps.values()) {
+                aborted &= step->abort();
             }
+            return aborted;
         }
         default:
             break;
@@ -222,6 +361,51 @@ void LaunchTask::onLogLines(const QStringList& lines, MessageLevel::Enum default
 }
 
 void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
+{
+    if (m_launched && !m_gameWindowSeen) {
+        if (!m_gameOutputSeen) {
+            m_gameOutputSeen = true;
+            m_trace.instant("First game output", "game");
+        }
+        // there is no direct signal for the window being shown, but the sound engine starts right after it on every
+        // modern version of the game
+        if (line.contains("Sound engine started")) {
+            m_gameWindowSeen = true;
+            m_trace.instant("Game window shown", "game");
+        }
+    }
+    // hold back lines of steps that run ahead of an unfinished one
+    if (auto step = qobject_cast<LaunchStep*>(sender())) {
+        bool ahead = true;
+        for (int i = 0; i <= m_logHead && i < m_steps.size(); i++) {
+            if (m_steps[i].get() == step) {
+                ahead = false;
+                break;
+            }
+        }
+        if (ahead) {
+            m_heldLogLines[step].append({ line, level });
+            return;
+        }
+    }
+    appendLogLine(line, level);
+}
+
+void LaunchTask::advanceLog(bool flushAll)
+{
+    while (m_logHead < m_steps.size()) {
+        auto step = m_steps[m_logHead].get();
+        for (auto& [line, level] : m_heldLogLines.take(step)) {
+            appendLogLine(line, level);
+        }
+        if (!flushAll && !step->isFinished()) {
+            break;
+        }
+        m_logHead++;
+    }
+}
+
+void LaunchTask::appendLogLine(QString line, MessageLevel::Enum level)
 {
     // if the launcher part set a log level, use it
     auto innerLevel = MessageLevel::fromLine(line);
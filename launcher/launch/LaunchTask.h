@@ -38,11 +38,15 @@
 #pragma once
 #include <QObjectPtr.h>
 #include <minecraft/MinecraftInstance.h>
+#include <QHash>
+#include <QPair>
 #include <QProcess>
+#include <QSet>
 #include "BaseInstance.h"
 #include "LaunchStep.h"
 #include "LogModel.h"
 #include "MessageLevel.h"
+#include "TimingTrace.h"
 
 class LaunchTask : public Task {
     Q_OBJECT
@@ -57,7 +61,20 @@ class LaunchTask : public Task {
     static shared_qobject_ptr<LaunchTask> create(MinecraftInstancePtr inst);
     virtual ~LaunchTask() = default;
 
+    /**
+     * @brief add a step that runs once all the steps added before it succeeded
+     */
     void appendStep(shared_qobject_ptr<LaunchStep> step);
+    /**
+     * @brief add a step that runs once the given steps succeeded, alongside any other step that is ready
+     *
+     * Steps still start in the order they were added in, and the log output of each step is kept together,
+     * in that same order.
+     */
+    void appendStep(shared_qobject_ptr<LaunchStep> step, const QList<LaunchStep*>& dependencies);
+    /**
+     * @brief add a step that runs before all the steps added so far
+     */
     void prependStep(shared_qobject_ptr<LaunchStep> step);
     void setCensorFilter(QMap<QString, QString> filter);
 
@@ -86,6 +103,11 @@ class LaunchTask : public Task {
 
     shared_qobject_ptr<LogModel> getLogModel();
 
+    /**
+     * @brief timings of the launch steps, from the start of the launch
+     */
+    const TimingTrace& trace() const { return m_trace; }
+
    public:
     void substituteVariables(QStringList& args) const;
     void substituteVariables(QString& cmd) const;
@@ -113,14 +135,41 @@ class LaunchTask : public Task {
     void onProgressReportingRequested();
 
    private: /*methods */
+    void startReadySteps();
     void finalizeSteps(bool successful, const QString& error);
+    void queueRequest(LaunchStep* step, bool progress);
+    void processNextRequest();
+    void appendLogLine(QString line, MessageLevel::Enum level);
+    void advanceLog(bool flushAll = false);
+    /// writes the trace next to the launcher logs, only when started with --trace-startup
+    void saveTrace();
 
    protected: /* data */
     MinecraftInstancePtr m_instance;
     shared_qobject_ptr<LogModel> m_logModel;
     QList<shared_qobject_ptr<LaunchStep>> m_steps;
+    QHash<LaunchStep*, QList<LaunchStep*>> m_dependencies;
     QMap<QString, QString> m_censorFilter;
-    int currentStep = -1;
+    // steps in the order they were started, finalized in reverse
+    QList<LaunchStep*> m_startedSteps;
+    QSet<LaunchStep*> m_runningSteps;
+    QString m_failReason;
+    bool m_failing = false;
+    bool m_finalized = false;
+    // only one step at a time gets to ask for progress reporting or launch confirmation
+    QList<QPair<LaunchStep*, bool>> m_requests;
+    LaunchStep* m_activeRequest = nullptr;
+    // output of steps running ahead of the first unfinished one is held back, to keep the log in order
+    int m_logHead = 0;
+    QHash<LaunchStep*, QList<QPair<QString, MessageLevel::Enum>>> m_heldLogLines;
     State state = NotStarted;
     qint64 m_pid = -1;
+    TimingTrace m_trace;
+    int m_launchEvent = -1;
+    // per step: trace event id and the network byte counter when it started
+    QHash<LaunchStep*, QPair<int, qint64>> m_stepEvents;
+    bool m_readyMarked = false;
+    bool m_launched = false;
+    bool m_gameOutputSeen = false;
+    bool m_gameWindowSeen = false;
 };
@@ -24,7 +24,11 @@
 class TaskStepWrapper : public LaunchStep {
     Q_OBJECT
    public:
-    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task) : LaunchStep(parent), m_task(task) {};
+    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task) : LaunchStep(parent), m_task(task)
+    {
+        // name the step after what it wraps, so it can be told apart in the launch timings
+        setObjectName(m_task->objectName().isEmpty() ? m_task->metaObject()->className() : m_task->objectName());
+    };
     virtual ~TaskStepWrapper() = default;
 
     void executeTask() override;
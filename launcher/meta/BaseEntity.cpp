@@ -42,7 +42,7 @@ class ParsingValidator : public Net::Validator {
         m_data.clear();
         return true;
     }
-    bool write(QByteArray& data) override
+    bool write(const QByteArray& data) override
     {
         this->m_data.append(data);
         return true;
@@ -19,6 +19,7 @@
 #include "QObjectPtr.h"
 #include "VersionList.h"
 #include "meta/BaseEntity.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/SequentialTask.h"
 
 namespace Meta {
@@ -150,6 +151,44 @@ Task::Ptr Index::loadVersion(const QString& uid, const QString& version, Net::Mo
     return loadTask;
 }
 
+Task::Ptr Index::loadVersions(const QList<std::pair<QString, QString>>& versions, Net::Mode mode)
+{
+    // group the versions by uid, so every list is only loaded once
+    QMap<QString, QStringList> versionsByUid;
+    for (auto& [uid, version] : versions) {
+        auto& uidVersions = versionsByUid[uid];
+        if (!uidVersions.contains(version))
+            uidVersions.append(version);
+    }
+
+    auto listsTask = makeShared<ConcurrentTask>(this, tr("Load meta for %n component(s)", "", versionsByUid.size()),
+                                                qMax(1, static_cast<int>(versionsByUid.size())));
+    for (auto it = versionsByUid.cbegin(); it != versionsByUid.cend(); ++it) {
+        auto versionList = get(it.key());
+        auto versionsTask = makeShared<ConcurrentTask>(this, tr("Load versions of %1").arg(it.key()), qMax(1, static_cast<int>(it->size())));
+        for (auto& version : *it) {
+            versionsTask->addTask(versionList->getVersion(version)->loadTask(mode));
+        }
+        if (mode == Net::Mode::Offline) {
+            listsTask->addTask(versionsTask);
+            continue;
+        }
+        // the list provides the checksums of its versions
+        auto listTask = makeShared<SequentialTask>(this, tr("Load meta for %1").arg(it.key()));
+        listTask->addTask(versionList->loadTask(mode));
+        listTask->addTask(versionsTask);
+        listsTask->addTask(listTask);
+    }
+
+    if (mode == Net::Mode::Offline || status() == BaseEntity::LoadStatus::Remote) {
+        return listsTask;
+    }
+    auto loadTask = makeShared<SequentialTask>(this, tr("Load meta index"));
+    loadTask->addTask(this->loadTask(mode));
+    loadTask->addTask(listsTask);
+    return loadTask;
+}
+
 Version::Ptr Index::getLoadedVersion(const QString& uid, const QString& version)
 {
     QEventLoop ev;
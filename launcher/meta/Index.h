@@ -50,6 +50,9 @@ class Index : public QAbstractListModel, public BaseEntity {
 
     Task::Ptr loadVersion(const QString& uid, const QString& version = {}, Net::Mode mode = Net::Mode::Online, bool force = false);
 
+    // loads many versions in one task: the index once, then every list and its versions concurrently
+    Task::Ptr loadVersions(const QList<std::pair<QString, QString>>& versions, Net::Mode mode = Net::Mode::Online);
+
     // this blocks until the version is loaded
     Version::Ptr getLoadedVersion(const QString& uid, const QString& version);
 
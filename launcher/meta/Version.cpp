@@ -19,7 +19,9 @@
 
 #include "JsonFormat.h"
 
-Meta::Version::Version(const QString& uid, const QString& version) : BaseVersion(), m_uid(uid), m_version(version) {}
+Meta::Version::Version(const QString& uid, const QString& version)
+    : BaseVersion(), m_uid(uid), m_version(version), m_comparableVersion(version)
+{}
 
 QString Meta::Version::descriptor()
 {
@@ -86,11 +88,6 @@ QString Meta::Version::localFilename() const
     return m_uid + '/' + m_version + ".json";
 }
 
-::Version Meta::Version::toComparableVersion() const
-{
-    return { const_cast<Meta::Version*>(this)->descriptor() };
-}
-
 void Meta::Version::setType(const QString& type)
 {
     m_type = type;
@@ -60,7 +60,7 @@ class Version : public QObject, public BaseVersion, public BaseEntity {
 
     QString localFilename() const override;
 
-    [[nodiscard]] ::Version toComparableVersion() const;
+    [[nodiscard]] const ::Version& toComparableVersion() const { return m_comparableVersion; }
 
    public:  // for usage by format parsers only
     void setType(const QString& type);
@@ -82,6 +82,8 @@ class Version : public QObject, public BaseVersion, public BaseEntity {
     QString m_name;
     QString m_uid;
     QString m_version;
+    /// m_version pre-tokenized once, for sorting and range checks
+    ::Version m_comparableVersion;
     QString m_type;
     qint64 m_time = 0;
     Meta::RequireSet m_requires;
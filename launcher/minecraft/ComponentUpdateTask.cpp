@@ -1,4 +1,5 @@
 #include "ComponentUpdateTask.h"
+#include <QSet>
 #include <algorithm>
 
 #include "Component.h"
@@ -98,12 +99,13 @@ static LoadResult loadComponent(ComponentPtr component, Task::Ptr& loadTask, Net
         if (metaVersion->isLoaded()) {
             component->m_loaded = true;
             result = LoadResult::LoadedLocal;
+        } else if (netmode == Net::Mode::Online) {
+            // loaded together with all other components, see ComponentUpdateTask::loadComponents
+            result = LoadResult::RequiresRemote;
         } else {
             loadTask = APPLICATION->metadataIndex()->loadVersion(component->m_uid, component->m_version, netmode);
             loadTask->start();
-            if (netmode == Net::Mode::Online)
-                result = LoadResult::RequiresRemote;
-            else if (metaVersion->isLoaded())
+            if (metaVersion->isLoaded())
                 result = LoadResult::LoadedLocal;
             else
                 result = LoadResult::Failed;
@@ -112,6 +114,69 @@ static LoadResult loadComponent(ComponentPtr component, Task::Ptr& loadTask, Net
     return result;
 }
 
+// HACK HACK HACK HACK FIXME: this is a placeholder for deciding what version to use. For now, it is hardcoded.
+static QString defaultRequirementVersion(const Meta::Require& require, const ComponentContainer& components)
+{
+    if (!require.equalsVersion.isEmpty()) {
+        return require.equalsVersion;
+    }
+    if (!require.suggests.isEmpty()) {
+        return require.suggests;
+    }
+    if (require.uid == "org.lwjgl") {
+        return "2.9.1";
+    }
+    if (require.uid == "org.lwjgl3") {
+        return "3.1.2";
+    }
+    if (require.uid == "net.fabricmc.intermediary" || require.uid == "org.quiltmc.hashed") {
+        auto minecraft =
+            std::find_if(components.begin(), components.end(), [](const ComponentPtr& cmp) { return cmp->getID() == "net.minecraft"; });
+        if (minecraft != components.end()) {
+            return (*minecraft)->getVersion();
+        }
+    }
+    return {};
+}
+
+/*
+ * Guess which versions dependency resolution will add once the components being loaded are known,
+ * so they can be fetched now instead of in another round of loading.
+ */
+static QList<std::pair<QString, QString>> likelyRequirements(const ComponentContainer& components)
+{
+    QSet<QString> present;
+    for (auto& component : components) {
+        present.insert(component->getID());
+    }
+
+    QList<std::pair<QString, QString>> out;
+    auto add = [&](const Meta::Require& require) {
+        if (present.contains(require.uid)) {
+            return;
+        }
+        auto version = defaultRequirementVersion(require, components);
+        if (version.isEmpty() || APPLICATION->metadataIndex()->get(require.uid, version)->isLoaded()) {
+            return;
+        }
+        present.insert(require.uid);
+        out.append({ require.uid, version });
+    };
+    for (auto& component : components) {
+        // the requirements stored in the pack profile are known before the version files are
+        for (auto& require : component->m_cachedRequires) {
+            add(require);
+        }
+        // new loader components have nothing cached yet, but always need the mappings for the Minecraft version
+        if (component->getID() == "net.fabricmc.fabric-loader" || component->getID() == "org.quiltmc.quilt-loader") {
+            Meta::Require intermediary;
+            intermediary.uid = "net.fabricmc.intermediary";
+            add(intermediary);
+        }
+    }
+    return out;
+}
+
 // FIXME: dead code. determine if this can still be useful?
 /*
 static LoadResult loadPackProfile(ComponentPtr component, Task::Ptr& loadTask, Net::Mode netmode)
@@ -147,6 +212,8 @@ void ComponentUpdateTask::loadComponents()
     size_t taskIndex = 0;
     size_t componentIndex = 0;
     d->remoteLoadSuccessful = true;
+    QList<std::pair<QString, QString>> remoteVersions;
+    QList<size_t> remoteComponents;
 
     // load all the components OR their lists...
     for (auto component : d->m_profile->d->components) {
@@ -180,6 +247,10 @@ void ComponentUpdateTask::loadComponents()
             component->updateCachedData();
         }
         result = composeLoadResult(result, singleResult);
+        if (singleResult == LoadResult::RequiresRemote && !loadTask) {
+            remoteVersions.append({ component->m_uid, component->m_version });
+            remoteComponents.append(componentIndex);
+        }
         if (loadTask) {
             qCDebug(instanceProfileResolveC) << d->m_profile->d->m_instance->name() << "|"
                                              << "Remote loading is being run for" << component->getName();
@@ -188,13 +259,41 @@ void ComponentUpdateTask::loadComponents()
             connect(loadTask.get(), &Task::aborted, this, [this, taskIndex]() { remoteLoadFailed(taskIndex, tr("Aborted")); });
             RemoteLoadStatus status;
             status.type = loadType;
-            status.PackProfileIndex = componentIndex;
+            status.PackProfileIndices = { componentIndex };
             status.task = loadTask;
             d->remoteLoadStatusList.append(status);
             taskIndex++;
         }
         componentIndex++;
     }
+    if (!remoteComponents.isEmpty()) {
+        qCDebug(instanceProfileResolveC) << d->m_profile->d->m_instance->name() << "|"
+                                         << "Remote loading is being run for" << remoteComponents.size() << "components";
+        // one batch for all components, so the index and each version list are only fetched once
+        auto loadTask = APPLICATION->metadataIndex()->loadVersions(remoteVersions, d->netmode);
+        connect(loadTask.get(), &Task::succeeded, this, [this, taskIndex]() { remoteLoadSucceeded(taskIndex); });
+        connect(loadTask.get(), &Task::failed, this, [this, taskIndex](const QString& error) { remoteLoadFailed(taskIndex, error); });
+        connect(loadTask.get(), &Task::aborted, this, [this, taskIndex]() { remoteLoadFailed(taskIndex, tr("Aborted")); });
+        RemoteLoadStatus status;
+        status.type = RemoteLoadStatus::Type::Version;
+        status.PackProfileIndices = remoteComponents;
+        status.task = loadTask;
+        d->remoteLoadStatusList.append(status);
+        taskIndex++;
+        loadTask->start();
+
+        // start on the versions the next round of dependency resolution will most likely need.
+        // these may turn out to be wrong, so they are kept separate and their failures are not errors
+        auto likely = likelyRequirements(d->m_profile->d->components);
+        if (!likely.isEmpty()) {
+            auto prefetchTask = APPLICATION->metadataIndex()->loadVersions(likely, d->netmode);
+            connect(prefetchTask.get(), &Task::failed, this, [](const QString& error) {
+                qCDebug(instanceProfileResolveC) << "Speculative metadata load failed:" << error;
+            });
+            d->prefetchTasks.append(prefetchTask);
+            prefetchTask->start();
+        }
+    }
     d->remoteTasksInProgress = taskIndex;
     switch (result) {
         case LoadResult::LoadedLocal: {
@@ -490,25 +589,7 @@ void ComponentUpdateTask::resolveDependencies(bool checkOnly)
             } else {
                 // version needs to be decided
                 qCDebug(instanceProfileResolveC) << "Adding" << add.uid << "at position" << add.indexOfFirstDependee;
-                // ############################################################################################################
-                // HACK HACK HACK HACK FIXME: this is a placeholder for deciding what version to use. For now, it is hardcoded.
-                if (!add.suggests.isEmpty()) {
-                    component->m_version = add.suggests;
-                } else {
-                    if (add.uid == "org.lwjgl") {
-                        component->m_version = "2.9.1";
-                    } else if (add.uid == "org.lwjgl3") {
-                        component->m_version = "3.1.2";
-                    } else if (add.uid == "net.fabricmc.intermediary" || add.uid == "org.quiltmc.hashed") {
-                        auto minecraft = std::find_if(components.begin(), components.end(),
-                                                      [](ComponentPtr& cmp) { return cmp->getID() == "net.minecraft"; });
-                        if (minecraft != components.end()) {
-                            component->m_version = (*minecraft)->getVersion();
-                        }
-                    }
-                }
-                // HACK HACK HACK HACK FIXME: this is a placeholder for deciding what version to use. For now, it is hardcoded.
-                // ############################################################################################################
+                component->m_version = defaultRequirementVersion(add, components);
             }
             component->m_dependencyOnly = true;
             // FIXME: this should not work directly with the component list
@@ -723,9 +804,11 @@ void ComponentUpdateTask::remoteLoadSucceeded(size_t taskIndex)
     d->remoteTasksInProgress--;
     // update the cached data of the component from the downloaded version file.
     if (taskSlot.type == RemoteLoadStatus::Type::Version) {
-        auto component = d->m_profile->getComponent(taskSlot.PackProfileIndex);
-        component->m_loaded = true;
-        component->updateCachedData();
+        for (auto index : taskSlot.PackProfileIndices) {
+            auto component = d->m_profile->getComponent(index);
+            component->m_loaded = true;
+            component->updateCachedData();
+        }
     }
     checkIfAllFinished();
 }
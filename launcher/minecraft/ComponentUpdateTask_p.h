@@ -12,7 +12,7 @@ class PackProfile;
 
 struct RemoteLoadStatus {
     enum class Type { Index, List, Version } type = Type::Version;
-    size_t PackProfileIndex = 0;
+    QList<size_t> PackProfileIndices;
     bool finished = false;
     bool succeeded = false;
     QString error;
@@ -24,6 +24,8 @@ struct ComponentUpdateTaskData {
     QList<RemoteLoadStatus> remoteLoadStatusList;
     bool remoteLoadSuccessful = true;
     size_t remoteTasksInProgress = 0;
+    // speculative loads of versions that dependency resolution is likely to add, their results are not waited for
+    QList<Task::Ptr> prefetchTasks;
     ComponentUpdateTask::Mode mode;
     Net::Mode netmode;
 };
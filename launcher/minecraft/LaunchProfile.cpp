@@ -34,7 +34,6 @@
  */
 
 #include "LaunchProfile.h"
-#include <Version.h>
 
 void LaunchProfile::clear()
 {
@@ -47,6 +46,7 @@ void LaunchProfile::clear()
     m_mainClass.clear();
     m_appletClass.clear();
     m_libraries.clear();
+    m_libraryIndex.clear();
     m_mavenFiles.clear();
     m_agents.clear();
     m_traits.clear();
@@ -124,39 +124,34 @@ void LaunchProfile::applyJarMods(const QList<LibraryPtr>& jarMods)
     this->m_jarMods.append(jarMods);
 }
 
-static int findLibraryByName(QList<LibraryPtr>* haystack, const GradleSpecifier& needle)
+static QString libraryIndexKey(const GradleSpecifier& spec)
 {
-    int retval = -1;
-    for (int i = 0; i < haystack->size(); ++i) {
-        if (haystack->at(i)->rawName().matchName(needle)) {
-            // only one is allowed.
-            if (retval != -1)
-                return -1;
-            retval = i;
-        }
+    // same identity as GradleSpecifier::matchName
+    return spec.groupId() + ':' + spec.artifactId() + ':' + spec.classifier();
+}
+
+static void mergeLibrary(QList<LibraryPtr>& list, QHash<QString, int>& index, LibraryPtr library)
+{
+    const auto key = libraryIndexKey(library->rawName());
+    auto existing = index.constFind(key);
+    // library not found? just add it.
+    if (existing == index.constEnd()) {
+        index.insert(key, list.size());
+        list.append(Library::limitedCopy(library));
+        return;
+    }
+
+    auto existingLibrary = list.at(*existing);
+    // if we are higher it means we should update
+    if (library->versionKey() > existingLibrary->versionKey()) {
+        list.replace(*existing, Library::limitedCopy(library));
     }
-    return retval;
 }
 
 void LaunchProfile::applyMods(const QList<LibraryPtr>& mods)
 {
-    QList<LibraryPtr>* list = &m_mods;
     for (auto& mod : mods) {
-        auto modCopy = Library::limitedCopy(mod);
-
-        // find the mod by name.
-        const int index = findLibraryByName(list, mod->rawName());
-        // mod not found? just add it.
-        if (index < 0) {
-            list->append(modCopy);
-            return;
-        }
-
-        auto existingLibrary = list->at(index);
-        // if we are higher it means we should update
-        if (Version(mod->version()) > Version(existingLibrary->version())) {
-            list->replace(index, modCopy);
-        }
+        mergeLibrary(m_mods, m_modIndex, mod);
     }
 }
 
@@ -177,25 +172,10 @@ void LaunchProfile::applyLibrary(LibraryPtr library, const RuntimeContext& runti
         return;
     }
 
-    QList<LibraryPtr>* list = &m_libraries;
     if (library->isNative()) {
-        list = &m_nativeLibraries;
-    }
-
-    auto libraryCopy = Library::limitedCopy(library);
-
-    // find the library by name.
-    const int index = findLibraryByName(list, library->rawName());
-    // library not found? just add it.
-    if (index < 0) {
-        list->append(libraryCopy);
-        return;
-    }
-
-    auto existingLibrary = list->at(index);
-    // if we are higher it means we should update
-    if (Version(library->version()) > Version(existingLibrary->version())) {
-        list->replace(index, libraryCopy);
+        mergeLibrary(m_nativeLibraries, m_nativeLibraryIndex, library);
+    } else {
+        mergeLibrary(m_libraries, m_libraryIndex, library);
     }
 }
 
@@ -315,6 +295,11 @@ const QList<LibraryPtr>& LaunchProfile::getJarMods() const
     return m_jarMods;
 }
 
+const QList<LibraryPtr>& LaunchProfile::getMods() const
+{
+    return m_mods;
+}
+
 const QList<LibraryPtr>& LaunchProfile::getLibraries() const
 {
     return m_libraries;
@@ -35,6 +35,7 @@
 
 #pragma once
 #include <ProblemProvider.h>
+#include <QHash>
 #include <QString>
 #include "Agent.h"
 #include "Library.h"
@@ -76,6 +77,7 @@ class LaunchProfile : public ProblemProvider {
     const QSet<QString>& getTraits() const;
     const QStringList& getTweakers() const;
     const QList<LibraryPtr>& getJarMods() const;
+    const QList<LibraryPtr>& getMods() const;
     const QList<LibraryPtr>& getLibraries() const;
     const QList<LibraryPtr>& getNativeLibraries() const;
     const QList<LibraryPtr>& getMavenFiles() const;
@@ -128,6 +130,9 @@ class LaunchProfile : public ProblemProvider {
     /// the list of libraries
     QList<LibraryPtr> m_libraries;
 
+    /// positions of the entries in m_libraries, keyed by group, artifact and classifier
+    QHash<QString, int> m_libraryIndex;
+
     /// the list of maven files to be placed in the libraries folder, but not acted upon
     QList<LibraryPtr> m_mavenFiles;
 
@@ -140,6 +145,9 @@ class LaunchProfile : public ProblemProvider {
     /// the list of native libraries
     QList<LibraryPtr> m_nativeLibraries;
 
+    /// positions of the entries in m_nativeLibraries, keyed by group, artifact and classifier
+    QHash<QString, int> m_nativeLibraryIndex;
+
     /// traits, collected from all the version files (version files can only add)
     QSet<QString> m_traits;
 
@@ -149,6 +157,9 @@ class LaunchProfile : public ProblemProvider {
     /// the list of mods
     QList<LibraryPtr> m_mods;
 
+    /// positions of the entries in m_mods, keyed by group, artifact and classifier
+    QHash<QString, int> m_modIndex;
+
     /// compatible java major versions
     QList<int> m_compatibleJavaMajors;
 
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LaunchProfileCache.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+#include "BuildConfig.h"
+#include "Exception.h"
+#include "FileSystem.h"
+#include "Json.h"
+#include "minecraft/LaunchProfile.h"
+#include "minecraft/Logging.h"
+#include "minecraft/OneSixVersionFormat.h"
+#include "minecraft/VersionFile.h"
+
+// bump when the way components are resolved or stored changes
+static const int currentCacheFormatVersion = 1;
+
+LaunchProfileCache::LaunchProfileCache(QString path) : m_path(std::move(path)) {}
+
+QByteArray LaunchProfileCache::computeKey(const QList<ComponentInput>& components)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto addString = [&hash](const QString& value) {
+        hash.addData(value.toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+    };
+
+    addString(QString::number(currentCacheFormatVersion));
+    addString(BuildConfig.printableVersionString());
+
+    for (auto& component : components) {
+        addString(component.uid);
+        addString(component.version);
+        addString(component.enabled ? "enabled" : "disabled");
+        addString(component.dependencyOnly ? "dependency" : "explicit");
+        if (!component.enabled) {
+            continue;
+        }
+        QFile file(component.file);
+        if (component.file.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        addString(component.file);
+        if (!hash.addData(&file)) {
+            return {};
+        }
+    }
+    return hash.result().toHex();
+}
+
+std::shared_ptr<LaunchProfile> LaunchProfileCache::load(const QByteArray& key, const RuntimeContext& runtimeContext) const
+{
+    if (key.isEmpty() || !QFile::exists(m_path)) {
+        return nullptr;
+    }
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_path));
+        if (Json::requireInteger(root, "formatVersion") != currentCacheFormatVersion) {
+            return nullptr;
+        }
+        if (Json::requireString(root, "key").toLatin1() != key) {
+            qCDebug(instanceProfileC) << "Cached components in" << m_path << "are out of date";
+            return nullptr;
+        }
+        auto profile = std::make_shared<LaunchProfile>();
+        for (auto value : Json::requireArray(root, "components")) {
+            auto obj = Json::requireObject(value);
+            if (!obj.contains("file")) {
+                profile->applyProblemSeverity(static_cast<ProblemSeverity>(Json::requireInteger(obj, "problemSeverity")));
+                continue;
+            }
+            auto file = OneSixVersionFormat::versionFileFromJson(QJsonDocument(Json::requireObject(obj, "file")), m_path, false);
+            // the stored problems include the ones parsing the file reports again, only add those it doesn't
+            auto parseProblems = file->getProblems();
+            for (auto problem : Json::ensureArray(obj, "problems")) {
+                auto problemObj = Json::requireObject(problem);
+                auto severity = static_cast<ProblemSeverity>(Json::requireInteger(problemObj, "severity"));
+                auto description = Json::requireString(problemObj, "description");
+                auto reported = std::any_of(parseProblems.begin(), parseProblems.end(), [&](const PatchProblem& other) {
+                    return other.m_severity == severity && other.m_description == description;
+                });
+                if (!reported) {
+                    file->addProblem(severity, description);
+                }
+            }
+            file->applyTo(profile.get(), runtimeContext);
+        }
+        return profile;
+    } catch (const Exception& e) {
+        qCWarning(instanceProfileC) << "Couldn't read cached components from" << m_path << ":" << e.cause();
+        return nullptr;
+    }
+}
+
+bool LaunchProfileCache::store(const QByteArray& key, const QList<Entry>& entries) const
+{
+    QJsonArray components;
+    for (auto& entry : entries) {
+        QJsonObject obj;
+        if (!entry.file) {
+            obj.insert("problemSeverity", static_cast<int>(entry.severity));
+            components.append(obj);
+            continue;
+        }
+        obj.insert("file", OneSixVersionFormat::versionFileToJson(entry.file).object());
+        QJsonArray problems;
+        for (auto& problem : entry.file->getProblems()) {
+            problems.append(QJsonObject{ { "severity", static_cast<int>(problem.m_severity) }, { "description", problem.m_description } });
+        }
+        if (!problems.isEmpty()) {
+            obj.insert("problems", problems);
+        }
+        components.append(obj);
+    }
+
+    QJsonObject root;
+    root.insert("formatVersion", currentCacheFormatVersion);
+    root.insert("key", QString::fromLatin1(key));
+    root.insert("components", components);
+    try {
+        FS::write(m_path, QJsonDocument(root).toJson(QJsonDocument::Compact));
+    } catch (const FS::FileSystemException& e) {
+        qCWarning(instanceProfileC) << "Couldn't store resolved components in" << m_path << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <memory>
+
+#include "ProblemProvider.h"
+#include "RuntimeContext.h"
+
+class LaunchProfile;
+class VersionFile;
+
+/**
+ * On-disk copy of the resolved component stack of an instance, used to build its launch profile without resolving.
+ *
+ * What is stored are the version files of the enabled components, in order, exactly as resolution left them. Building
+ * the profile from those is cheap and, unlike storing the final profile, stays correct when the runtime context
+ * changes (java architecture, ...).
+ * The stored data is only used while its key matches, the key being a hash of everything resolution depends on:
+ * the component list and the contents of the version files of the components.
+ */
+class LaunchProfileCache {
+   public:
+    struct ComponentInput {
+        QString uid;
+        QString version;
+        bool enabled = true;
+        bool dependencyOnly = false;
+        /// the version file (custom patch or meta file) the component is built from
+        QString file;
+    };
+
+    struct Entry {
+        /// null if the component has no version file, in which case only the severity is applied
+        std::shared_ptr<VersionFile> file;
+        ProblemSeverity severity = ProblemSeverity::None;
+    };
+
+    explicit LaunchProfileCache(QString path);
+
+    /// returns an empty key if any of the inputs can't be read
+    static QByteArray computeKey(const QList<ComponentInput>& components);
+
+    /// returns the profile built from the stored components, if they were stored with the given key
+    std::shared_ptr<LaunchProfile> load(const QByteArray& key, const RuntimeContext& runtimeContext) const;
+    bool store(const QByteArray& key, const QList<Entry>& entries) const;
+
+   private:
+    QString m_path;
+};
@@ -42,11 +42,13 @@
 #include <QStringList>
 #include <QUrl>
 #include <memory>
+#include <optional>
 
 #include "GradleSpecifier.h"
 #include "MojangDownloadInfo.h"
 #include "Rule.h"
 #include "RuntimeContext.h"
+#include "Version.h"
 #include "net/NetRequest.h"
 
 class Library;
@@ -76,6 +78,7 @@ class Library {
         newlib->m_storagePrefix = base->m_storagePrefix;
         newlib->m_mojangDownloads = base->m_mojangDownloads;
         newlib->m_filename = base->m_filename;
+        newlib->m_versionKey = base->m_versionKey;
         return newlib;
     }
 
@@ -83,7 +86,11 @@ class Library {
     /// Returns the raw name field
     const GradleSpecifier& rawName() const { return m_name; }
 
-    void setRawName(const GradleSpecifier& spec) { m_name = spec; }
+    void setRawName(const GradleSpecifier& spec)
+    {
+        m_name = spec;
+        m_versionKey.reset();
+    }
 
     void setClassifier(const QString& spec) { m_name.setClassifier(spec); }
 
@@ -96,6 +103,14 @@ class Library {
     /// get the artifact version
     QString version() const { return m_name.version(); }
 
+    /// get the artifact version, parsed once for comparisons
+    const Version& versionKey() const
+    {
+        if (!m_versionKey)
+            m_versionKey = Version(m_name.version());
+        return *m_versionKey;
+    }
+
     /// Returns true if the library is native
     bool isNative() const { return m_nativeClassifiers.size() != 0; }
 
@@ -207,4 +222,7 @@ class Library {
 
     /// MOJANG: container with Mojang style download info
     MojangLibraryDownloadInfo::Ptr m_mojangDownloads;
+
+    /// cached parse of the artifact version, see versionKey()
+    mutable std::optional<Version> m_versionKey;
 };
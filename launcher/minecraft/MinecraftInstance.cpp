@@ -87,6 +87,7 @@
 #include "PackProfile.h"
 #include "minecraft/gameoptions/GameOptions.h"
 #include "minecraft/update/FoldersTask.h"
+#include "tasks/ConcurrentTask.h"
 
 #include "tools/BaseProfiler.h"
 
@@ -120,13 +121,13 @@ class OrSetting : public Setting {
 
 MinecraftInstance::MinecraftInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr settings, const QString& rootDir)
     : BaseInstance(globalSettings, settings, rootDir)
-{
-    m_components.reset(new PackProfile(this));
-}
+{}
 
 void MinecraftInstance::saveNow()
 {
-    m_components->saveNow();
+    if (m_components) {
+        m_components->saveNow();
+    }
 }
 
 void MinecraftInstance::loadSpecificSettings()
@@ -217,7 +218,9 @@ void MinecraftInstance::loadSpecificSettings()
 void MinecraftInstance::updateRuntimeContext()
 {
     m_runtimeContext.updateFromInstanceSettings(m_settings);
-    m_components->invalidateLaunchProfile();
+    if (m_components) {
+        m_components->invalidateLaunchProfile();
+    }
 }
 
 QString MinecraftInstance::typeName() const
@@ -227,6 +230,10 @@ QString MinecraftInstance::typeName() const
 
 std::shared_ptr<PackProfile> MinecraftInstance::getPackProfile() const
 {
+    // created on first use, most instances in the list never need their components
+    if (!m_components) {
+        m_components.reset(new PackProfile(const_cast<MinecraftInstance*>(this)));
+    }
     return m_components;
 }
 
@@ -402,21 +409,21 @@ QDir MinecraftInstance::versionsPath() const
 QStringList MinecraftInstance::getClassPath()
 {
     QStringList jars, nativeJars;
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     profile->getLibraryFiles(runtimeContext(), jars, nativeJars, getLocalLibraryPath(), binRoot());
     return jars;
 }
 
 QString MinecraftInstance::getMainClass() const
 {
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     return profile->getMainClass();
 }
 
 QStringList MinecraftInstance::getNativeJars()
 {
     QStringList jars, nativeJars;
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     profile->getLibraryFiles(runtimeContext(), jars, nativeJars, getLocalLibraryPath(), binRoot());
     return nativeJars;
 }
@@ -431,11 +438,11 @@ QStringList MinecraftInstance::extraArguments()
     if (!jarMods.isEmpty()) {
         list.append({ "-Dfml.ignoreInvalidMinecraftCertificates=true", "-Dfml.ignorePatchDiscrepancies=true" });
     }
-    auto addn = m_components->getProfile()->getAddnJvmArguments();
+    auto addn = getPackProfile()->getProfile()->getAddnJvmArguments();
     if (!addn.isEmpty()) {
         list.append(addn);
     }
-    auto agents = m_components->getProfile()->getAgents();
+    auto agents = getPackProfile()->getProfile()->getAgents();
     for (auto agent : agents) {
         QStringList jar, temp1, temp2, temp3;
         agent->library()->getApplicableFiles(runtimeContext(), jar, temp1, temp2, temp3, getLocalLibraryPath());
@@ -656,7 +663,7 @@ static QString replaceTokensIn(QString text, QMap<QString, QString> with)
 
 QStringList MinecraftInstance::processMinecraftArgs(AuthSessionPtr session, MinecraftTarget::Ptr targetToJoin) const
 {
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     QString args_pattern = profile->getMinecraftArguments();
     for (auto tweaker : profile->getTweakers()) {
         args_pattern += " --tweakClass " + tweaker;
@@ -719,9 +726,7 @@ QString MinecraftInstance::createLaunchScript(AuthSessionPtr session, MinecraftT
 {
     QString launchScript;
 
-    if (!m_components)
-        return QString();
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     if (!profile)
         return QString();
 
@@ -799,7 +804,7 @@ QStringList MinecraftInstance::verboseDescription(AuthSessionPtr session, Minecr
     out << "Main Class:" << "  " + getMainClass() << "";
     out << "Native path:" << "  " + getNativePath() << "";
 
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
 
     // traits
     auto alltraits = traits();
@@ -1000,11 +1005,11 @@ QString MinecraftInstance::getStatusbarDescription()
         traits.append(tr("broken"));
     }
 
-    QString mcVersion = m_components->getComponentVersion("net.minecraft");
+    QString mcVersion = getPackProfile()->getComponentVersion("net.minecraft");
     if (mcVersion.isEmpty()) {
         // Load component info if needed
-        m_components->reload(Net::Mode::Offline);
-        mcVersion = m_components->getComponentVersion("net.minecraft");
+        getPackProfile()->reload(Net::Mode::Offline, true);
+        mcVersion = getPackProfile()->getComponentVersion("net.minecraft");
     }
 
     QString description;
@@ -1033,7 +1038,7 @@ QString MinecraftInstance::getStatusbarDescription()
 QList<LaunchStep::Ptr> MinecraftInstance::createUpdateTask()
 {
     return {
-        // create folders
+        // create folders, the launch runs this before the others
         makeShared<FoldersTask>(this),
         // libraries download
         makeShared<LibrariesTask>(this),
@@ -1091,55 +1096,67 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
     }
 
     // load meta
-    {
-        auto mode = session->status != AuthSession::PlayableOffline ? Net::Mode::Online : Net::Mode::Offline;
-        process->appendStep(makeShared<TaskStepWrapper>(pptr, makeShared<MinecraftLoadAndCheck>(this, mode, pptr)));
-    }
+    auto mode = session->status != AuthSession::PlayableOffline ? Net::Mode::Online : Net::Mode::Offline;
+    auto loadMeta = makeShared<TaskStepWrapper>(pptr, makeShared<MinecraftLoadAndCheck>(this, mode, pptr));
+    process->appendStep(loadMeta);
 
-    // check java
-    {
-        process->appendStep(makeShared<AutoInstallJava>(pptr));
-        process->appendStep(makeShared<CheckJava>(pptr));
-    }
+    // check java, probing it can happen while the account is claimed
+    auto autoInstallJava = makeShared<AutoInstallJava>(pptr);
+    process->appendStep(autoInstallJava);
+    auto checkJava = makeShared<CheckJava>(pptr);
+    process->appendStep(checkJava, { autoInstallJava.get() });
+
+    // the last step the game files depend on
+    LaunchStep* gameFilesReady = autoInstallJava.get();
 
     // if we aren't in offline mode,.
     if (session->status != AuthSession::PlayableOffline) {
         if (!session->demo) {
-            process->appendStep(makeShared<ClaimAccount>(pptr, session));
-        }
-        for (auto t : createUpdateTask()) {
-            process->appendStep(makeShared<TaskStepWrapper>(pptr, t));
+            auto claimAccount = makeShared<ClaimAccount>(pptr, session);
+            process->appendStep(claimAccount, { gameFilesReady });
+            gameFilesReady = claimAccount.get();
         }
+        auto updateTasks = createUpdateTask();
+        auto folders = makeShared<TaskStepWrapper>(pptr, updateTasks.takeFirst());
+        process->appendStep(folders, { gameFilesReady });
+
+        // libraries and assets come from different places, download them at the same time
+        auto downloads = makeShared<ConcurrentTask>(nullptr, tr("Update game files"));
+        for (auto task : updateTasks)
+            downloads->addTask(task);
+        auto update = makeShared<TaskStepWrapper>(pptr, downloads);
+        // the natives to download depend on the architecture of the java that CheckJava found
+        process->appendStep(update, { folders.get(), checkJava.get() });
+        gameFilesReady = update.get();
     }
 
     // if there are any jar mods
     {
-        process->appendStep(makeShared<ModMinecraftJar>(pptr));
+        process->appendStep(makeShared<ModMinecraftJar>(pptr), { gameFilesReady });
     }
 
     // Scan mods folders for mods
     {
-        process->appendStep(makeShared<ScanModFolders>(pptr));
+        process->appendStep(makeShared<ScanModFolders>(pptr), { loadMeta.get() });
     }
 
     // print some instance info here...
-    {
-        process->appendStep(makeShared<PrintInstanceInfo>(pptr, session, targetToJoin));
-    }
+    auto printInstanceInfo = makeShared<PrintInstanceInfo>(pptr, session, targetToJoin);
+    process->appendStep(printInstanceInfo);
 
     // extract native jars if needed
     {
-        process->appendStep(makeShared<ExtractNatives>(pptr));
+        process->appendStep(makeShared<ExtractNatives>(pptr), { printInstanceInfo.get() });
     }
 
     // reconstruct assets if needed
     {
-        process->appendStep(makeShared<ReconstructAssets>(pptr));
+        process->appendStep(makeShared<ReconstructAssets>(pptr), { printInstanceInfo.get() });
     }
 
     // verify that minimum Java requirements are met
     {
-        process->appendStep(makeShared<VerifyJavaInstall>(pptr));
+        process->appendStep(makeShared<VerifyJavaInstall>(pptr), { printInstanceInfo.get() });
     }
 
     {
@@ -1242,7 +1259,7 @@ std::shared_ptr<GameOptions> MinecraftInstance::gameOptionsModel()
 
 QList<Mod*> MinecraftInstance::getJarMods() const
 {
-    auto profile = m_components->getProfile();
+    auto profile = getPackProfile()->getProfile();
     QList<Mod*> mods;
     for (auto jarmod : profile->getJarMods()) {
         QStringList jar, temp1, temp2, temp3;
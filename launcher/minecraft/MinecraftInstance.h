@@ -163,7 +163,7 @@ class MinecraftInstance : public BaseInstance {
     QMap<QString, QString> createCensorFilterFromSession(AuthSessionPtr session);
 
    protected:  // data
-    std::shared_ptr<PackProfile> m_components;
+    mutable std::shared_ptr<PackProfile> m_components;
     mutable std::shared_ptr<ModFolderModel> m_loader_mod_list;
     mutable std::shared_ptr<ModFolderModel> m_core_mod_list;
     mutable std::shared_ptr<ModFolderModel> m_nil_mod_list;
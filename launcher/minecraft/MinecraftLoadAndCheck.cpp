@@ -10,7 +10,7 @@ void MinecraftLoadAndCheck::executeTask()
 {
     // add offline metadata load task
     auto components = m_inst->getPackProfile();
-    components->reload(m_netmode);
+    components->reload(m_netmode, true);
     m_task = components->getCurrentTask();
 
     if (!m_task) {
@@ -337,7 +337,7 @@ QJsonDocument OneSixVersionFormat::versionFileToJson(const VersionFilePtr& patch
     }
     if (!patch->mods.isEmpty()) {
         QJsonArray array;
-        for (auto value : patch->jarMods) {
+        for (auto value : patch->mods) {
             array.append(OneSixVersionFormat::modtoJson(value.get()));
         }
         root.insert("mods", array);
@@ -58,6 +58,7 @@
 #include "meta/Index.h"
 #include "meta/JsonFormat.h"
 #include "minecraft/Component.h"
+#include "minecraft/LaunchProfileCache.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/OneSixVersionFormat.h"
 #include "minecraft/ProfileUtils.h"
@@ -265,6 +266,12 @@ QString PackProfile::componentsFilePath() const
     return FS::PathCombine(d->m_instance->instanceRoot(), "mmc-pack.json");
 }
 
+QString PackProfile::launchProfileCachePath() const
+{
+    // kept out of the instance folder, so copies and exports of the instance don't carry it along
+    return FS::PathCombine("cache", "launchprofiles", d->m_instance->id() + ".json");
+}
+
 QString PackProfile::patchesPattern() const
 {
     return FS::PathCombine(d->m_instance->instanceRoot(), "patches", "%1.json");
@@ -312,11 +319,12 @@ bool PackProfile::load()
         }
         endResetModel();
         d->loaded = true;
+        d->resolved = false;
         return true;
     }
 }
 
-void PackProfile::reload(Net::Mode netmode)
+void PackProfile::reload(Net::Mode netmode, bool allowCachedProfile)
 {
     // Do not reload when the update/resolve task is running. It is in control.
     if (d->m_updateTask) {
@@ -330,6 +338,10 @@ void PackProfile::reload(Net::Mode netmode)
     invalidateLaunchProfile();
 
     if (load()) {
+        if (allowCachedProfile && loadCachedLaunchProfile()) {
+            qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Using the cached launch profile, skipping resolution";
+            return;
+        }
         resolve(netmode);
     }
 }
@@ -353,6 +365,7 @@ void PackProfile::updateSucceeded()
 {
     qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Component list update/resolve task succeeded";
     d->m_updateTask.reset();
+    d->resolved = true;
     invalidateLaunchProfile();
 }
 
@@ -942,8 +955,67 @@ bool PackProfile::installAgents_internal(QStringList filepaths)
     return true;
 }
 
+QByteArray PackProfile::launchProfileCacheKey() const
+{
+    QList<LaunchProfileCache::ComponentInput> inputs;
+    for (auto& component : d->components) {
+        LaunchProfileCache::ComponentInput input;
+        input.uid = component->m_uid;
+        input.version = component->m_version;
+        input.enabled = component->isEnabled();
+        input.dependencyOnly = component->m_dependencyOnly;
+        // same lookup order as ComponentUpdateTask: a custom patch wins over the metadata
+        auto patchFile = patchFilePathForUid(component->m_uid);
+        if (QFile::exists(patchFile)) {
+            input.file = patchFile;
+        } else if (!component->m_version.isEmpty()) {
+            input.file = QDir("meta").absoluteFilePath(component->m_uid + '/' + component->m_version + ".json");
+        }
+        inputs.append(input);
+    }
+    return LaunchProfileCache::computeKey(inputs);
+}
+
+bool PackProfile::loadCachedLaunchProfile() const
+{
+    auto key = launchProfileCacheKey();
+    if (key.isEmpty()) {
+        return false;
+    }
+    auto profile = LaunchProfileCache(launchProfileCachePath()).load(key, d->m_instance->runtimeContext());
+    if (!profile) {
+        return false;
+    }
+    d->m_profile = profile;
+    d->m_profileCacheKey = key;
+    return true;
+}
+
+void PackProfile::storeResolvedComponents() const
+{
+    auto key = launchProfileCacheKey();
+    if (key.isEmpty() || key == d->m_profileCacheKey) {
+        return;
+    }
+    QList<LaunchProfileCache::Entry> entries;
+    for (auto& component : d->components) {
+        // mirrors Component::applyTo
+        if (!component->isEnabled()) {
+            continue;
+        }
+        entries.append({ component->getVersionFile(), component->getProblemSeverity() });
+    }
+    if (LaunchProfileCache(launchProfileCachePath()).store(key, entries)) {
+        d->m_profileCacheKey = key;
+    }
+}
+
 std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
 {
+    // components that were not resolved can't be applied, use what the last resolution left behind if it's still valid
+    if (!d->m_profile && d->loaded && !d->resolved && !d->m_updateTask) {
+        loadCachedLaunchProfile();
+    }
     if (!d->m_profile) {
         try {
             auto profile = std::make_shared<LaunchProfile>();
@@ -953,6 +1025,9 @@ std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
                 file->applyTo(profile.get());
             }
             d->m_profile = profile;
+            if (d->resolved && profile->getProblemSeverity() != ProblemSeverity::Error) {
+                storeResolvedComponents();
+            }
         } catch (const Exception& error) {
             qCWarning(instanceProfileC) << d->m_instance->name() << "|" << "Couldn't apply profile patches because: " << error.cause();
         }
@@ -101,8 +101,13 @@ class PackProfile : public QAbstractListModel {
 
     bool revertToBase(int index);
 
-    /// reload the list, reload all components, resolve dependencies
-    void reload(Net::Mode netmode);
+    /**
+     * reload the list, reload all components, resolve dependencies
+     *
+     * With allowCachedProfile set, resolution is skipped when the launch profile stored by an earlier resolution
+     * is still valid for the components on disk.
+     */
+    void reload(Net::Mode netmode, bool allowCachedProfile = false);
 
     // reload all components, resolve dependencies
     void resolve(Net::Mode netmode);
@@ -155,11 +160,16 @@ class PackProfile : public QAbstractListModel {
     void scheduleSave();
     bool saveIsScheduled() const;
 
+    QByteArray launchProfileCacheKey() const;
+    bool loadCachedLaunchProfile() const;
+    void storeResolvedComponents() const;
+
     /// insert component so that its index is ideally the specified one (returns real index)
     void insertComponent(size_t index, ComponentPtr component);
 
     QString componentsFilePath() const;
     QString patchesPattern() const;
+    QString launchProfileCachePath() const;
 
    private slots:
     void save_internal();
@@ -16,6 +16,8 @@ struct PackProfileData {
 
     // the launch profile (volatile, temporary thing created on demand)
     std::shared_ptr<LaunchProfile> m_profile;
+    // key of the launch profile last read from or written to the on-disk cache
+    QByteArray m_profileCacheKey;
 
     // persistent list of components and related machinery
     ComponentContainer components;
@@ -24,5 +26,7 @@ struct PackProfileData {
     QTimer m_saveTimer;
     Task::Ptr m_updateTask;
     bool loaded = false;
+    // the components went through a successful update/resolve task since they were loaded
+    bool resolved = false;
     bool interactionDisabled = true;
 };
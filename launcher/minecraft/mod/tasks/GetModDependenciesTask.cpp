@@ -19,8 +19,10 @@
 #include "GetModDependenciesTask.h"
 
 #include <QDebug>
+#include <QSet>
 #include <algorithm>
 #include <memory>
+#include "Application.h"
 #include "Json.h"
 #include "QObjectPtr.h"
 #include "minecraft/PackProfile.h"
@@ -29,6 +31,7 @@
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/SequentialTask.h"
 #include "ui/pages/modplatform/ModModel.h"
 #include "ui/pages/modplatform/flame/FlameResourceModels.h"
@@ -78,9 +81,66 @@ void GetModDependenciesTask::prepare()
     for (auto sel : m_selected) {
         if (checkDependencies(sel, m_version, m_loaderType))
             for (auto dep : getDependenciesForVersion(sel->version, sel->pack->provider)) {
-                addTask(prepareDependencyTask(dep, sel->pack->provider, 20));
+                queueDependency(dep, sel->pack->provider, 20);
             }
     }
+    scheduleNextLevel();
+}
+
+auto GetModDependenciesTask::getProvider(ModPlatform::ResourceProvider name) const -> const Provider&
+{
+    return name == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
+}
+
+void GetModDependenciesTask::queueDependency(const ModPlatform::Dependency& dep, ModPlatform::ResourceProvider providerName, int level)
+{
+    auto pDep = std::make_shared<PackDependency>();
+    pDep->dependency = dep;
+    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
+    pDep->pack->addonId = dep.addonId;
+    pDep->pack->provider = providerName;
+
+    m_pack_dependencies.append(pDep);
+    m_next_level.append({ pDep, level });
+}
+
+/*
+ * Dependencies are resolved one level of the tree at a time.
+ * Every level fetches the project info of all its dependencies in one bulk request per provider,
+ * the versions (in bulk where the API allows it) concurrently, and queues the dependencies it finds for the next level.
+ */
+void GetModDependenciesTask::scheduleNextLevel()
+{
+    if (m_next_level.isEmpty())
+        return;
+    auto current = m_next_level;
+    m_next_level.clear();
+
+    auto levelTask = makeShared<ConcurrentTask>(this, tr("Resolve dependencies"), APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    for (auto& provider : { m_flame_provider, m_modrinth_provider }) {
+        QList<std::shared_ptr<PackDependency>> projects;
+        QList<PendingDependency> versionIds;
+        for (auto& pending : current) {
+            if (pending.pDep->pack->provider != provider.name)
+                continue;
+            if (!pending.pDep->pack->addonId.toString().isEmpty())
+                projects.append(pending.pDep);
+            if (pending.infoOnly)
+                continue;
+            if (provider.name == ModPlatform::ResourceProvider::MODRINTH && !pending.pDep->dependency.version.isEmpty()) {
+                versionIds.append(pending);
+            } else if (auto task = getDependencyVersionTask(pending); task) {
+                levelTask->addTask(task);
+            }
+        }
+        if (!projects.isEmpty())
+            levelTask->addTask(getProjectsInfoTask(provider, projects));
+        if (!versionIds.isEmpty())
+            levelTask->addTask(getVersionsTask(versionIds));
+    }
+    // connected before this task starts running it, so the next level is queued before it moves on
+    connect(levelTask.get(), &Task::succeeded, this, &GetModDependenciesTask::scheduleNextLevel);
+    addTask(levelTask);
 }
 
 ModPlatform::Dependency GetModDependenciesTask::getOverride(const ModPlatform::Dependency& dep,
@@ -143,121 +203,188 @@ QList<ModPlatform::Dependency> GetModDependenciesTask::getDependenciesForVersion
     return c_dependencies;
 }
 
-Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDependency> pDep)
+Task::Ptr GetModDependenciesTask::getProjectsInfoTask(const Provider& provider, const QList<std::shared_ptr<PackDependency>>& deps)
 {
-    auto provider = pDep->pack->provider == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
+    QHash<QString, std::shared_ptr<PackDependency>> byId;
+    for (auto& pDep : deps)
+        byId.insert(pDep->pack->addonId.toString(), pDep);
+
     auto responseInfo = std::make_shared<QByteArray>();
-    auto info = provider.api->getProject(pDep->pack->addonId.toString(), responseInfo);
-    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDep] {
+    auto info = byId.size() == 1 ? provider.api->getProject(byId.keys().first(), responseInfo)
+                                 : provider.api->getProjects(byId.keys(), responseInfo);
+    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, byId] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*responseInfo, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
-            removePack(pDep->pack->addonId);
+            for (auto& pDep : byId)
+                removePack(pDep->pack->addonId);
             qWarning() << "Error while parsing JSON response for mod info at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qDebug() << *responseInfo;
             return;
         }
+        auto missing = byId;
         try {
-            auto obj = provider.name == ModPlatform::ResourceProvider::FLAME ? Json::requireObject(Json::requireObject(doc), "data")
-                                                                             : Json::requireObject(doc);
-            provider.mod->loadIndexedPack(*pDep->pack, obj);
+            QJsonArray entries;
+            if (provider.name == ModPlatform::ResourceProvider::FLAME) {
+                if (byId.size() == 1)
+                    entries = { Json::requireObject(Json::requireObject(doc), "data") };
+                else
+                    entries = Json::requireArray(Json::requireObject(doc), "data");
+            } else {
+                if (byId.size() == 1)
+                    entries = { Json::requireObject(doc) };
+                else
+                    entries = Json::requireArray(doc);
+            }
+            for (auto entry : entries) {
+                auto obj = Json::requireObject(entry);
+                auto id = provider.name == ModPlatform::ResourceProvider::FLAME ? QString::number(Json::requireInteger(obj, "id"))
+                                                                                : Json::requireString(obj, "id");
+                auto pDep = missing.take(id);
+                if (!pDep) {
+                    qWarning() << "Invalid project id from the API response:" << id;
+                    continue;
+                }
+                try {
+                    provider.mod->loadIndexedPack(*pDep->pack, obj);
+                } catch (const JSONValidationError& e) {
+                    removePack(pDep->pack->addonId);
+                    qDebug() << obj;
+                    qWarning() << "Error while reading mod info: " << e.cause();
+                }
+            }
         } catch (const JSONValidationError& e) {
-            removePack(pDep->pack->addonId);
             qDebug() << doc;
             qWarning() << "Error while reading mod info: " << e.cause();
         }
+        for (auto& pDep : missing)
+            removePack(pDep->pack->addonId);
     });
     return info;
 }
 
-Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Dependency& dep,
-                                                        const ModPlatform::ResourceProvider providerName,
-                                                        int level)
+Task::Ptr GetModDependenciesTask::getVersionsTask(const QList<PendingDependency>& pending)
 {
-    auto pDep = std::make_shared<PackDependency>();
-    pDep->dependency = dep;
-    pDep->pack = std::make_shared<ModPlatform::IndexedPack>();
-    pDep->pack->addonId = dep.addonId;
-    pDep->pack->provider = providerName;
-
-    m_pack_dependencies.append(pDep);
-    auto provider = providerName == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
-
-    auto tasks = makeShared<SequentialTask>(
-        this, QString("DependencyInfo: %1").arg(dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString()));
+    QHash<QString, PendingDependency> byVersion;
+    for (auto& p : pending)
+        byVersion.insert(p.pDep->dependency.version, p);
+
+    auto response = std::make_shared<QByteArray>();
+    auto api = std::static_pointer_cast<ModrinthAPI>(m_modrinth_provider.api);
+    auto task = api->getVersions(byVersion.keys(), response);
+    QObject::connect(task.get(), &NetJob::succeeded, [this, response, byVersion] {
+        QJsonParseError parse_error{};
+        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            for (auto& p : byVersion)
+                m_pack_dependencies.removeAll(p.pDep);
+            qWarning() << "Error while parsing JSON response for getting versions at " << parse_error.offset
+                       << " reason: " << parse_error.errorString();
+            qWarning() << *response;
+            return;
+        }
+        auto missing = byVersion;
+        try {
+            for (auto entry : Json::requireArray(doc)) {
+                auto obj = Json::requireObject(entry);
+                auto id = Json::requireString(obj, "id");
+                if (!missing.contains(id))
+                    continue;
+                auto p = missing.take(id);
+                QJsonDocument versionDoc(obj);
+                loadDependencyVersion(p, versionDoc);
+            }
+        } catch (const JSONValidationError& e) {
+            qDebug() << doc;
+            qWarning() << "Error while reading mod versions: " << e.cause();
+        }
+        for (auto& p : missing) {
+            qWarning() << "Mod version" << p.pDep->dependency.version << "was not found";
+            m_pack_dependencies.removeAll(p.pDep);
+        }
+    });
+    return task;
+}
 
-    if (!dep.addonId.toString().isEmpty()) {
-        tasks->addTask(getProjectInfoTask(pDep));
-    }
+Task::Ptr GetModDependenciesTask::getDependencyVersionTask(const PendingDependency& pending)
+{
+    auto& dep = pending.pDep->dependency;
+    auto& provider = getProvider(pending.pDep->pack->provider);
 
     ResourceAPI::DependencySearchArgs args = { dep, m_version, m_loaderType };
     ResourceAPI::DependencySearchCallbacks callbacks;
     callbacks.on_fail = [](QString reason, int) {
         qCritical() << tr("A network error occurred. Could not load project dependencies:%1").arg(reason);
     };
-    callbacks.on_succeed = [dep, provider, pDep, level, this](auto& doc, [[maybe_unused]] auto& pack) {
-        try {
-            QJsonArray arr;
-            if (dep.version.length() != 0 && doc.isObject()) {
-                arr.append(doc.object());
-            } else {
-                arr = doc.isObject() ? Json::ensureArray(doc.object(), "data") : doc.array();
-            }
-            pDep->version = provider.mod->loadDependencyVersions(dep, arr);
-            if (!pDep->version.addonId.isValid()) {
-                if (m_loaderType & ModPlatform::Quilt) {  // falback for quilt
-                    auto overide = ModPlatform::getOverrideDeps();
-                    auto over = std::find_if(overide.cbegin(), overide.cend(),
-                                             [dep, provider](auto o) { return o.provider == provider.name && dep.addonId == o.quilt; });
-                    if (over != overide.cend()) {
-                        removePack(dep.addonId);
-                        addTask(prepareDependencyTask({ over->fabric, dep.type }, provider.name, level));
-                        return;
-                    }
+    callbacks.on_succeed = [pending, this](auto& doc, [[maybe_unused]] auto& pack) { loadDependencyVersion(pending, doc); };
+
+    return provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
+}
+
+void GetModDependenciesTask::loadDependencyVersion(const PendingDependency& pending, QJsonDocument& doc)
+{
+    auto pDep = pending.pDep;
+    auto dep = pDep->dependency;
+    auto level = pending.level;
+    auto& provider = getProvider(pDep->pack->provider);
+    try {
+        QJsonArray arr;
+        if (dep.version.length() != 0 && doc.isObject()) {
+            arr.append(doc.object());
+        } else {
+            arr = doc.isObject() ? Json::ensureArray(doc.object(), "data") : doc.array();
+        }
+        pDep->version = provider.mod->loadDependencyVersions(dep, arr);
+        if (!pDep->version.addonId.isValid()) {
+            if (m_loaderType & ModPlatform::Quilt) {  // falback for quilt
+                auto overide = ModPlatform::getOverrideDeps();
+                auto over = std::find_if(overide.cbegin(), overide.cend(),
+                                         [dep, provider](auto o) { return o.provider == provider.name && dep.addonId == o.quilt; });
+                if (over != overide.cend()) {
+                    removePack(dep.addonId);
+                    queueDependency({ over->fabric, dep.type }, provider.name, level);
+                    return;
                 }
-                removePack(dep.addonId);
-                qWarning() << "Error while reading mod version empty ";
-                qDebug() << doc;
-                return;
             }
-            pDep->version.is_currently_selected = true;
-            pDep->pack->versions = { pDep->version };
-            pDep->pack->versionsLoaded = true;
-
-        } catch (const JSONValidationError& e) {
             removePack(dep.addonId);
+            qWarning() << "Error while reading mod version empty ";
             qDebug() << doc;
-            qWarning() << "Error while reading mod version: " << e.cause();
             return;
         }
-        if (level == 0) {
-            removePack(dep.addonId);
-            qWarning() << "Dependency cycle exceeded";
-            return;
-        }
-        if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
-            pDep->pack->addonId = pDep->version.addonId;
-            auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider.name);
-            if (dep_.addonId != pDep->version.addonId) {
-                removePack(pDep->version.addonId);
-                addTask(prepareDependencyTask(dep_, provider.name, level));
-            } else {
-                addTask(getProjectInfoTask(pDep));
-            }
-        }
-        if (isLocalyInstalled(pDep)) {
+        pDep->version.is_currently_selected = true;
+        pDep->pack->versions = { pDep->version };
+        pDep->pack->versionsLoaded = true;
+
+    } catch (const JSONValidationError& e) {
+        removePack(dep.addonId);
+        qDebug() << doc;
+        qWarning() << "Error while reading mod version: " << e.cause();
+        return;
+    }
+    if (level == 0) {
+        removePack(dep.addonId);
+        qWarning() << "Dependency cycle exceeded";
+        return;
+    }
+    if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
+        pDep->pack->addonId = pDep->version.addonId;
+        auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider.name);
+        if (dep_.addonId != pDep->version.addonId) {
             removePack(pDep->version.addonId);
+            queueDependency(dep_, provider.name, level);
             return;
         }
-        for (auto dep_ : getDependenciesForVersion(pDep->version, provider.name)) {
-            addTask(prepareDependencyTask(dep_, provider.name, level - 1));
-        }
-    };
-
-    auto version = provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
-    tasks->addTask(version);
-    return tasks;
+        // the project was only known by its version, its info is fetched with the next level
+        m_next_level.append({ pDep, level, true });
+    }
+    if (isLocalyInstalled(pDep)) {
+        removePack(pDep->version.addonId);
+        return;
+    }
+    for (auto dep_ : getDependenciesForVersion(pDep->version, provider.name)) {
+        queueDependency(dep_, provider.name, level - 1);
+    }
 }
 
 void GetModDependenciesTask::removePack(const QVariant& addonId)
@@ -276,29 +403,40 @@ void GetModDependenciesTask::removePack(const QVariant& addonId)
 
 auto GetModDependenciesTask::getExtraInfo() -> QHash<QString, PackDependencyExtraInfo>
 {
-    QHash<QString, PackDependencyExtraInfo> rby;
     auto fullList = m_selected + m_pack_dependencies;
+
+    // index the required dependencies of every mod by what they point at, the project or (for Modrinth) the exact version
+    auto depKey = [](ModPlatform::ResourceProvider provider, bool byVersion, const QString& id) {
+        return QString("%1|%2|%3").arg(ModPlatform::ProviderCapabilities::name(provider), byVersion ? "version" : "project", id);
+    };
+    QHash<QString, QList<int>> requiredBy;
+    for (int i = 0; i < fullList.size(); i++) {
+        auto& smod = fullList[i];
+        auto provider = smod->pack->provider;
+        QSet<QString> keys;
+        for (auto& d : smod->version.dependencies) {
+            if (d.type != ModPlatform::DependencyType::REQUIRED)
+                continue;
+            auto byVersion = provider == ModPlatform::ResourceProvider::MODRINTH && d.addonId.toString().isEmpty();
+            keys.insert(depKey(provider, byVersion, byVersion ? d.version : d.addonId.toString()));
+        }
+        for (auto& key : keys)
+            requiredBy[key].append(i);
+    }
+
+    QHash<QString, PackDependencyExtraInfo> rby;
     for (auto& mod : fullList) {
-        auto addonId = mod->pack->addonId;
         auto provider = mod->pack->provider;
-        auto version = mod->version.fileId;
+        auto indices = requiredBy.value(depKey(provider, false, mod->pack->addonId.toString()));
+        if (provider == ModPlatform::ResourceProvider::MODRINTH)
+            indices += requiredBy.value(depKey(provider, true, mod->version.fileId.toString()));
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
         auto req = QStringList();
-        for (auto& smod : fullList) {
-            if (provider != smod->pack->provider)
-                continue;
-            auto deps = smod->version.dependencies;
-            if (auto dep = std::find_if(deps.begin(), deps.end(),
-                                        [addonId, provider, version](const ModPlatform::Dependency& d) {
-                                            return d.type == ModPlatform::DependencyType::REQUIRED &&
-                                                   (provider == ModPlatform::ResourceProvider::MODRINTH && d.addonId.toString().isEmpty()
-                                                        ? version == d.version
-                                                        : d.addonId == addonId);
-                                        });
-                dep != deps.end()) {
-                req.append(smod->pack->name);
-            }
-        }
-        rby[addonId.toString()] = { maybeInstalled(mod), req };
+        for (auto i : indices)
+            req.append(fullList[i]->pack->name);
+        rby[mod->pack->addonId.toString()] = { maybeInstalled(mod), req };
     }
     return rby;
 }
@@ -70,11 +70,10 @@ class GetModDependenciesTask : public SequentialTask {
     QHash<QString, PackDependencyExtraInfo> getExtraInfo();
 
    protected slots:
-    Task::Ptr prepareDependencyTask(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int);
     QList<ModPlatform::Dependency> getDependenciesForVersion(const ModPlatform::IndexedVersion&,
                                                              ModPlatform::ResourceProvider providerName);
     void prepare();
-    Task::Ptr getProjectInfoTask(std::shared_ptr<PackDependency> pDep);
+    void scheduleNextLevel();
     ModPlatform::Dependency getOverride(const ModPlatform::Dependency&, ModPlatform::ResourceProvider providerName);
     void removePack(const QVariant& addonId);
 
@@ -82,7 +81,23 @@ class GetModDependenciesTask : public SequentialTask {
     bool maybeInstalled(std::shared_ptr<PackDependency> pDep);
 
    private:
+    // a dependency waiting to be resolved in the next level of the breadth first search
+    struct PendingDependency {
+        std::shared_ptr<PackDependency> pDep;
+        int level;
+        // the version is already known, only the project info is missing
+        bool infoOnly = false;
+    };
+
+    void queueDependency(const ModPlatform::Dependency&, ModPlatform::ResourceProvider, int level);
+    const Provider& getProvider(ModPlatform::ResourceProvider name) const;
+    Task::Ptr getProjectsInfoTask(const Provider& provider, const QList<std::shared_ptr<PackDependency>>& deps);
+    Task::Ptr getVersionsTask(const QList<PendingDependency>& pending);
+    Task::Ptr getDependencyVersionTask(const PendingDependency& pending);
+    void loadDependencyVersion(const PendingDependency& pending, QJsonDocument& doc);
+
     QList<std::shared_ptr<PackDependency>> m_pack_dependencies;
+    QList<PendingDependency> m_next_level;
     QList<std::shared_ptr<Metadata::ModStruct>> m_mods;
     QList<std::shared_ptr<PackDependency>> m_selected;
     QStringList m_mods_file_names;
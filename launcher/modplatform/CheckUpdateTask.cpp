@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CheckUpdateTask.h"
+
+#include <QCache>
+#include <QDateTime>
+
+namespace {
+struct Lookup {
+    QJsonObject result;
+    QDateTime time;
+};
+
+// enough for the mods of a few large instances, the least recently used lookups make room for new ones
+constexpr int MAX_LOOKUPS = 2000;
+
+QCache<QString, Lookup>& lookups()
+{
+    static QCache<QString, Lookup> cache(MAX_LOOKUPS);
+    return cache;
+}
+}  // namespace
+
+std::optional<QJsonObject> CheckUpdateTask::cachedLookup(const QString& key)
+{
+    auto& cache = lookups();
+    auto lookup = cache.object(key);
+    if (!lookup)
+        return {};
+    if (lookup->time.secsTo(QDateTime::currentDateTimeUtc()) > LOOKUP_TTL) {
+        cache.remove(key);
+        return {};
+    }
+    return lookup->result;
+}
+
+void CheckUpdateTask::storeLookup(const QString& key, const QJsonObject& result)
+{
+    lookups().insert(key, new Lookup{ result, QDateTime::currentDateTimeUtc() });
+}
+
+QString CheckUpdateTask::gameVersionsKey() const
+{
+    QStringList versions;
+    for (auto& version : m_game_versions)
+        versions.append(version.toString());
+    return versions.join(',');
+}
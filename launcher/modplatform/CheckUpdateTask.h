@@ -1,5 +1,8 @@
 #pragma once
 
+#include <QJsonObject>
+#include <optional>
+
 #include "minecraft/mod/Mod.h"
 #include "minecraft/mod/tasks/GetModDependenciesTask.h"
 #include "modplatform/ModIndex.h"
@@ -64,6 +67,17 @@ class CheckUpdateTask : public Task {
     void checkFailed(Mod* failed, QString reason, QUrl recover_url = {});
 
    protected:
+    /**
+     * Results of API lookups, shared by every update check in the launcher.
+     * Mods present in several instances, and checks that run again shortly after, reuse them instead of asking the API again.
+     */
+    static constexpr qint64 LOOKUP_TTL = 10 * 60;
+    static std::optional<QJsonObject> cachedLookup(const QString& key);
+    static void storeLookup(const QString& key, const QJsonObject& result);
+
+    /// the game versions being checked against, as part of lookup keys
+    QString gameVersionsKey() const;
+
     QList<Mod*>& m_mods;
     std::list<Version>& m_game_versions;
     QList<ModPlatform::ModLoaderType> m_loaders_list;
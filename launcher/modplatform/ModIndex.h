@@ -100,6 +100,7 @@ struct IndexedVersion {
     QString downloadUrl;
     QString date;
     QString fileName;
+    qint64 size = 0;  // in bytes, 0 when unknown
     ModLoaderTypes loaders = {};
     QString hash_type;
     QString hash;
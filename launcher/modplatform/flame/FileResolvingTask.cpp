@@ -132,7 +132,8 @@ void Flame::FileResolvingTask::netJobFinished()
     }
     m_result.reset(new QByteArray());
     m_task = modrinthAPI.currentVersions(hashes, "sha1", m_result);
-    (dynamic_cast<NetJob*>(m_task.get()))->setAskRetry(false);
+    if (auto job = qobject_cast<NetJob*>(m_task.get()))
+        job->setAskRetry(false);
     auto step_progress = std::make_shared<TaskStepProgress>();
     connect(m_task.get(), &Task::finished, this, [this, step_progress]() {
         step_progress->state = TaskStepState::Succeeded;
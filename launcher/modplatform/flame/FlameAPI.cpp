@@ -10,6 +10,7 @@
 #include "Application.h"
 #include "Json.h"
 #include "modplatform/ModIndex.h"
+#include "modplatform/helpers/CachedApiRequest.h"
 #include "net/ApiDownload.h"
 #include "net/ApiUpload.h"
 #include "net/NetJob.h"
@@ -223,9 +224,9 @@ QList<ResourceAPI::SortingMethod> FlameAPI::getSortingMethods() const
 
 Task::Ptr FlameAPI::getCategories(std::shared_ptr<QByteArray> response, ModPlatform::ResourceType type)
 {
-    auto netJob = makeShared<NetJob>(QString("Flame::GetCategories"), APPLICATION->network());
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(
-        QUrl(QString("https://api.curseforge.com/v1/categories?gameId=432&classId=%1").arg(getClassId(type))), response));
+    auto netJob = makeShared<CachedApiRequest>(
+        QString("Flame::GetCategories"), QUrl(QString("https://api.curseforge.com/v1/categories?gameId=432&classId=%1").arg(getClassId(type))),
+        response, CachedApiRequest::CATEGORIES_TTL);
     QObject::connect(netJob.get(), &Task::failed, [](QString msg) { qDebug() << "Flame failed to get categories:" << msg; });
     return netJob;
 }
@@ -36,6 +36,16 @@ class FlameAPI : public NetworkResourceAPI {
         return loaders & (ModPlatform::NeoForge | ModPlatform::Forge | ModPlatform::Fabric | ModPlatform::Quilt);
     }
 
+    /// whether a CurseForge ModLoaderType, as found in the API responses, is one of the given loaders
+    static bool isModLoader(int mappedModLoader, ModPlatform::ModLoaderTypes loaders)
+    {
+        for (auto loader : { ModPlatform::NeoForge, ModPlatform::Forge, ModPlatform::Fabric, ModPlatform::Quilt }) {
+            if (loaders & loader && getMappedModLoader(loader) == mappedModLoader)
+                return true;
+        }
+        return false;
+    }
+
    private:
     static int getClassId(ModPlatform::ResourceType type)
     {
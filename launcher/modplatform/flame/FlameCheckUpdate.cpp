@@ -3,7 +3,7 @@
 #include "FlameAPI.h"
 #include "FlameModIndex.h"
 
-#include <MurmurHash2.h>
+#include <algorithm>
 #include <memory>
 
 #include "Json.h"
@@ -13,141 +13,209 @@
 #include "minecraft/mod/ModFolderModel.h"
 #include "minecraft/mod/tasks/GetModDependenciesTask.h"
 
-#include "net/ApiDownload.h"
+#include "modplatform/helpers/CachedApiRequest.h"
+#include "tasks/ConcurrentTask.h"
 
 static FlameAPI api;
 
 bool FlameCheckUpdate::abort()
 {
-    m_was_aborted = true;
-    if (m_net_job)
-        return m_net_job->abort();
+    if (m_job)
+        return m_job->abort();
     return true;
 }
 
-ModPlatform::IndexedPack FlameCheckUpdate::getProjectInfo(ModPlatform::IndexedVersion& ver_info)
+/* Check for update:
+ * - Get the projects of every mod in one call, they list their latest files
+ * - Get the latest files of every mod in one call
+ * - Compare hash of the latest version with the current hash
+ * - If equal, no updates, else, there's updates, so add to the list
+ * */
+void FlameCheckUpdate::executeTask()
 {
-    ModPlatform::IndexedPack pack;
+    setStatus(tr("Preparing mods for CurseForge..."));
+    setProgress(0, 3);
+
+    QStringList missing;
+    for (auto* mod : m_mods) {
+        auto id = mod->metadata()->project_id.toString();
+        if (m_projects.contains(id) || missing.contains(id))
+            continue;
+        if (auto cached = cachedLookup("flame/project/" + id); cached.has_value())
+            m_projects.insert(id, cached.value());
+        else
+            missing.append(id);
+    }
 
-    QEventLoop loop;
+    if (missing.isEmpty()) {
+        getFiles();
+        return;
+    }
 
-    auto get_project_job = new NetJob("Flame::GetProjectJob", APPLICATION->network());
+    setStatus(tr("Getting API response from CurseForge for %n mod(s)...", nullptr, missing.size()));
 
     auto response = std::make_shared<QByteArray>();
-    auto url = QString("https://api.curseforge.com/v1/mods/%1").arg(ver_info.addonId.toString());
-    auto dl = Net::ApiDownload::makeByteArray(url, response);
-    get_project_job->addNetAction(dl);
-
-    QObject::connect(get_project_job, &NetJob::succeeded, [response, &pack]() {
+    auto job = api.getProjects(missing, response);
+    connect(job.get(), &Task::succeeded, this, [this, response] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
             qWarning() << "Error while parsing JSON response from FlameCheckUpdate at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
+            emitFailed(parse_error.errorString());
             return;
         }
 
         try {
-            auto doc_obj = Json::requireObject(doc);
-            auto data_obj = Json::requireObject(doc_obj, "data");
-            FlameMod::loadIndexedPack(pack, data_obj);
+            for (auto entry : Json::requireArray(Json::requireObject(doc), "data")) {
+                auto obj = Json::requireObject(entry);
+                auto id = QString::number(Json::requireInteger(obj, "id"));
+                m_projects.insert(id, obj);
+                storeLookup("flame/project/" + id, obj);
+            }
         } catch (Json::JsonException& e) {
             qWarning() << e.cause();
             qDebug() << doc;
         }
+        getFiles();
     });
+    connect(job.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
+    m_job = job;
+    job->start();
+}
 
-    connect(get_project_job, &NetJob::failed, this, &FlameCheckUpdate::emitFailed);
-    QObject::connect(get_project_job, &NetJob::finished, [&loop, get_project_job] {
-        get_project_job->deleteLater();
-        loop.quit();
-    });
-
-    get_project_job->start();
-    loop.exec();
+QString FlameCheckUpdate::latestFileId(const QJsonObject& project, Mod* mod) const
+{
+    // The project lists the latest file for each game version and loader, which is all we need to know here
+    auto indexes = Json::ensureArray(project, "latestFilesIndexes");
+    auto game_version = m_game_versions.empty() ? QString() : m_game_versions.front().toString();
+
+    auto bestFile = [&indexes, &game_version](ModPlatform::ModLoaderTypes loaders) {
+        int best = 0;
+        for (auto index_value : indexes) {
+            auto index = index_value.toObject();
+            if (!game_version.isEmpty() && index.value("gameVersion").toString() != game_version)
+                continue;
+            if (!FlameAPI::isModLoader(index.value("modLoader").toInt(), loaders))
+                continue;
+            // file ids only ever grow, so the highest one is the newest file
+            best = std::max(best, index.value("fileId").toInt());
+        }
+        return best;
+    };
 
-    return pack;
+    // edge case: mod has installed for forge but the instance is fabric => fabric version will be prioritizated on update
+    for (auto loader : m_loaders_list) {
+        if (auto id = bestFile(loader); id != 0)
+            return QString::number(id);
+    }
+    if (auto id = bestFile(mod->loaders()); id != 0)
+        return QString::number(id);
+    return {};
 }
 
-ModPlatform::IndexedVersion FlameCheckUpdate::getFileInfo(int addonId, int fileId)
+void FlameCheckUpdate::getFiles()
 {
-    ModPlatform::IndexedVersion ver;
+    setStatus(tr("Getting the latest files from CurseForge..."));
+    setProgress(1, 3);
 
-    QEventLoop loop;
+    QStringList missing;
+    auto need = [this, &missing](const QString& id) {
+        if (m_files.contains(id) || missing.contains(id))
+            return;
+        if (auto cached = cachedLookup("flame/file/" + id); cached.has_value())
+            m_files.insert(id, cached.value());
+        else
+            missing.append(id);
+    };
 
-    auto get_file_info_job = new NetJob("Flame::GetFileInfoJob", APPLICATION->network());
+    for (auto* mod : m_mods) {
+        auto project = m_projects.value(mod->metadata()->project_id.toString());
+        if (project.isEmpty())
+            continue;
+        auto file_id = latestFileId(project, mod);
+        if (file_id.isEmpty())
+            continue;
+        m_latest_files.insert(mod, file_id);
+        need(file_id);
 
-    auto response = std::make_shared<QByteArray>();
-    auto url = QString("https://api.curseforge.com/v1/mods/%1/files/%2").arg(QString::number(addonId), QString::number(fileId));
-    auto dl = Net::ApiDownload::makeByteArray(url, response);
-    get_file_info_job->addNetAction(dl);
+        // the installed file tells which version is installed, when the mod itself doesn't
+        if (mod->version().isEmpty() && mod->status() != ModStatus::NotInstalled)
+            need(mod->metadata()->file_id.toString());
+    }
+
+    if (missing.isEmpty()) {
+        checkFiles();
+        return;
+    }
 
-    QObject::connect(get_file_info_job, &NetJob::succeeded, [response, &ver]() {
+    auto response = std::make_shared<QByteArray>();
+    auto job = api.getFiles(missing, response);
+    connect(job.get(), &Task::succeeded, this, [this, response] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
             qWarning() << "Error while parsing JSON response from FlameCheckUpdate at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
+            emitFailed(parse_error.errorString());
             return;
         }
 
         try {
-            auto doc_obj = Json::requireObject(doc);
-            auto data_obj = Json::requireObject(doc_obj, "data");
-            ver = FlameMod::loadIndexedPackVersion(data_obj);
+            for (auto entry : Json::requireArray(Json::requireObject(doc), "data")) {
+                auto obj = Json::requireObject(entry);
+                auto id = QString::number(Json::requireInteger(obj, "id"));
+                m_files.insert(id, obj);
+                storeLookup("flame/file/" + id, obj);
+            }
         } catch (Json::JsonException& e) {
             qWarning() << e.cause();
             qDebug() << doc;
         }
+        checkFiles();
     });
-    connect(get_file_info_job, &NetJob::failed, this, &FlameCheckUpdate::emitFailed);
-    QObject::connect(get_file_info_job, &NetJob::finished, [&loop, get_file_info_job] {
-        get_file_info_job->deleteLater();
-        loop.quit();
-    });
-
-    get_file_info_job->start();
-    loop.exec();
-
-    return ver;
+    connect(job.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
+    m_job = job;
+    job->start();
 }
 
-/* Check for update:
- * - Get latest version available
- * - Compare hash of the latest version with the current hash
- * - If equal, no updates, else, there's updates, so add to the list
- * */
-void FlameCheckUpdate::executeTask()
+void FlameCheckUpdate::checkFiles()
 {
-    setStatus(tr("Preparing mods for CurseForge..."));
+    setStatus(tr("Parsing the API response from CurseForge..."));
+    setProgress(2, 3);
 
-    int i = 0;
+    QList<std::pair<size_t, ModPlatform::IndexedVersion>> updated;
     for (auto* mod : m_mods) {
-        setStatus(tr("Getting API response from CurseForge for '%1'...").arg(mod->name()));
-        setProgress(i++, m_mods.size());
-
-        auto latest_vers = api.getLatestVersions({ { mod->metadata()->project_id.toString() }, m_game_versions });
+        auto file = m_files.value(m_latest_files.value(mod));
 
-        // Check if we were aborted while getting the latest version
-        if (m_was_aborted) {
-            aborted();
-            return;
+        ModPlatform::IndexedVersion latest_ver;
+        try {
+            if (!file.isEmpty())
+                latest_ver = FlameMod::loadIndexedPackVersion(file);
+        } catch (Json::JsonException& e) {
+            qWarning() << e.cause();
+            qDebug() << file;
         }
-        auto latest_ver = api.getLatestVersion(latest_vers, m_loaders_list, mod->loaders());
-
-        setStatus(tr("Parsing the API response from CurseForge for '%1'...").arg(mod->name()));
 
-        if (!latest_ver.has_value() || !latest_ver->addonId.isValid()) {
+        if (!latest_ver.addonId.isValid()) {
             emit checkFailed(mod, tr("No valid version found for this mod. It's probably unavailable for the current game "
                                      "version / mod loader."));
             continue;
         }
 
-        if (latest_ver->downloadUrl.isEmpty() && latest_ver->fileId != mod->metadata()->file_id) {
-            auto pack = getProjectInfo(latest_ver.value());
-            auto recover_url = QString("%1/download/%2").arg(pack.websiteUrl, latest_ver->fileId.toString());
+        if (latest_ver.downloadUrl.isEmpty() && latest_ver.fileId != mod->metadata()->file_id) {
+            ModPlatform::IndexedPack pack;
+            try {
+                auto project = m_projects.value(mod->metadata()->project_id.toString());
+                FlameMod::loadIndexedPack(pack, project);
+            } catch (Json::JsonException& e) {
+                qWarning() << e.cause();
+            }
+            auto recover_url = QString("%1/download/%2").arg(pack.websiteUrl, latest_ver.fileId.toString());
             emit checkFailed(mod, tr("Mod has a new update available, but is not downloadable using CurseForge."), recover_url);
 
             continue;
@@ -163,20 +231,63 @@ void FlameCheckUpdate::executeTask()
             pack->authors.append({ author });
         pack->description = mod->description();
         pack->provider = ModPlatform::ResourceProvider::FLAME;
-        if (!latest_ver->hash.isEmpty() && (mod->metadata()->hash != latest_ver->hash || mod->status() == ModStatus::NotInstalled)) {
+        if (!latest_ver.hash.isEmpty() && (mod->metadata()->hash != latest_ver.hash || mod->status() == ModStatus::NotInstalled)) {
             auto old_version = mod->version();
             if (old_version.isEmpty() && mod->status() != ModStatus::NotInstalled) {
-                auto current_ver = getFileInfo(latest_ver->addonId.toInt(), mod->metadata()->file_id.toInt());
-                old_version = current_ver.version;
+                auto current_file = m_files.value(mod->metadata()->file_id.toString());
+                try {
+                    if (!current_file.isEmpty())
+                        old_version = FlameMod::loadIndexedPackVersion(current_file).version;
+                } catch (Json::JsonException& e) {
+                    qWarning() << e.cause();
+                }
             }
 
-            auto download_task = makeShared<ResourceDownloadTask>(pack, latest_ver.value(), m_mods_folder);
-            m_updatable.emplace_back(pack->name, mod->metadata()->hash, old_version, latest_ver->version, latest_ver->version_type,
-                                     api.getModFileChangelog(latest_ver->addonId.toInt(), latest_ver->fileId.toInt()),
+            auto download_task = makeShared<ResourceDownloadTask>(pack, latest_ver, m_mods_folder);
+            m_updatable.emplace_back(pack->name, mod->metadata()->hash, old_version, latest_ver.version, latest_ver.version_type, QString(),
                                      ModPlatform::ResourceProvider::FLAME, download_task, mod->enabled());
+            updated.append({ m_updatable.size() - 1, latest_ver });
         }
-        m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, latest_ver.value()));
+        m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, latest_ver));
+    }
+
+    getChangelogs(updated);
+}
+
+void FlameCheckUpdate::getChangelogs(const QList<std::pair<size_t, ModPlatform::IndexedVersion>>& versions)
+{
+    if (versions.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
+
+    setStatus(tr("Getting the changelogs from CurseForge..."));
+
+    // There is no bulk endpoint for changelogs, so at least they are fetched together
+    auto job = makeShared<ConcurrentTask>(this, "Flame::FileChangelogs", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    for (auto& [index, version] : versions) {
+        auto url =
+            QString("https://api.curseforge.com/v1/mods/%1/files/%2/changelog").arg(version.addonId.toString(), version.fileId.toString());
+        auto response = std::make_shared<QByteArray>();
+        auto request =
+            makeShared<CachedApiRequest>(QString("Flame::FileChangelog"), QUrl(url), response, CachedApiRequest::PROJECT_TTL);
+        connect(request.get(), &Task::succeeded, this, [this, index = index, response] {
+            QJsonParseError parse_error{};
+            QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+            if (parse_error.error != QJsonParseError::NoError) {
+                qWarning() << "Error while parsing JSON response from Flame::FileChangelog at " << parse_error.offset
+                           << " reason: " << parse_error.errorString();
+                return;
+            }
+            m_updatable[index].changelog = Json::ensureString(doc.object(), "data");
+        });
+        job->addTask(request);
     }
 
-    emitSucceeded();
+    // A missing changelog is not worth failing the update check for
+    connect(job.get(), &Task::succeeded, this, &FlameCheckUpdate::emitSucceeded);
+    connect(job.get(), &Task::failed, this, &FlameCheckUpdate::emitSucceeded);
+    connect(job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
+    m_job = job;
+    job->start();
 }
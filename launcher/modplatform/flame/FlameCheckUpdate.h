@@ -19,12 +19,17 @@ class FlameCheckUpdate : public CheckUpdateTask {
 
    protected slots:
     void executeTask() override;
+    void getFiles();
+    void checkFiles();
 
    private:
-    ModPlatform::IndexedPack getProjectInfo(ModPlatform::IndexedVersion& ver_info);
-    ModPlatform::IndexedVersion getFileInfo(int addonId, int fileId);
+    /// the id of the newest file of the project for the instance, or an empty string if there is none
+    QString latestFileId(const QJsonObject& project, Mod* mod) const;
+    void getChangelogs(const QList<std::pair<size_t, ModPlatform::IndexedVersion>>& versions);
 
-    NetJob* m_net_job = nullptr;
+    Task::Ptr m_job = nullptr;
 
-    bool m_was_aborted = false;
+    QHash<QString, QJsonObject> m_projects;
+    QHash<QString, QJsonObject> m_files;
+    QHash<Mod*, QString> m_latest_files;
 };
@@ -482,6 +482,7 @@ void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
             blocked_mod.name = result.version.fileName;
             blocked_mod.websiteUrl = QString("%1/download/%2").arg(result.pack.websiteUrl, QString::number(result.fileId));
             blocked_mod.hash = result.version.hash;
+            blocked_mod.size = result.version.size;
             blocked_mod.matched = false;
             blocked_mod.localPath = "";
             blocked_mod.targetFolder = result.targetFolder;
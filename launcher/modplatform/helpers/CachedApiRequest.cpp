@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CachedApiRequest.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+
+#include "Application.h"
+#include "net/ApiDownload.h"
+
+namespace {
+struct InFlightRequest {
+    NetJob::Ptr job;
+    /// where the response ends up, the metacache entry of a stored request or the buffer of one kept in memory
+    MetaEntryPtr entry;
+    std::shared_ptr<QByteArray> data;
+    int users = 0;
+};
+
+// requests that are currently running, by cache key
+QHash<QString, InFlightRequest>& inFlight()
+{
+    static QHash<QString, InFlightRequest> requests;
+    return requests;
+}
+
+struct RecentResponse {
+    QByteArray data;
+    qint64 fetched;
+};
+
+// responses of short-lived requests, kept in memory only: every search would otherwise leave a file behind
+QCache<QString, RecentResponse>& recentResponses()
+{
+    static QCache<QString, RecentResponse> responses(64);
+    return responses;
+}
+
+QString cacheKey(const QUrl& url)
+{
+    auto hash = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1);
+    return url.host() + '/' + QString::fromLatin1(hash.toHex()) + ".json";
+}
+}  // namespace
+
+CachedApiRequest::CachedApiRequest(QString name, QUrl url, std::shared_ptr<QByteArray> response, qint64 time_to_live)
+    : m_name(name), m_url(url), m_key(cacheKey(url)), m_response(response), m_time_to_live(time_to_live)
+{}
+
+CachedApiRequest::~CachedApiRequest()
+{
+    detach();
+}
+
+void CachedApiRequest::executeTask()
+{
+    auto& requests = inFlight();
+    auto it = requests.find(m_key);
+    if (it == requests.end()) {
+        auto job = makeShared<NetJob>(m_name, APPLICATION->network());
+        MetaEntryPtr entry;
+        std::shared_ptr<QByteArray> data;
+        if (m_time_to_live > SEARCH_TTL) {
+            entry = APPLICATION->metacache()->resolveEntry("ModPlatformAPI", m_key);
+            entry->setTimeToLive(m_time_to_live);
+            // fall back to the stored response when the request fails
+            job->addNetAction(Net::ApiDownload::makeCached(m_url, entry, Net::Download::Option::AcceptLocalFiles));
+        } else {
+            auto now = QDateTime::currentSecsSinceEpoch();
+            if (auto recent = recentResponses().object(m_key); recent && now - recent->fetched < m_time_to_live) {
+                *m_response = recent->data;
+                emitSucceeded();
+                return;
+            }
+            data = std::make_shared<QByteArray>();
+            job->addNetAction(Net::ApiDownload::makeByteArray(m_url, data));
+            connect(job.get(), &Task::succeeded, job.get(), [key = m_key, data] {
+                recentResponses().insert(key, new RecentResponse{ *data, QDateTime::currentSecsSinceEpoch() });
+            });
+        }
+
+        auto key = m_key;
+        auto* raw_job = job.get();
+        connect(raw_job, &Task::finished, raw_job, [key, raw_job] {
+            auto& requests = inFlight();
+            if (auto it = requests.find(key); it != requests.end() && it->job.get() == raw_job)
+                requests.erase(it);
+        });
+
+        it = requests.insert(m_key, { job, entry, data, 0 });
+    } else {
+        qDebug() << "Joining running request for" << m_url.toString();
+    }
+
+    it->users++;
+    m_job = it->job;
+    m_entry = it->entry;
+    m_data = it->data;
+
+    connect(m_job.get(), &Task::succeeded, this, &CachedApiRequest::readResponse);
+    connect(m_job.get(), &Task::failed, this, [this](QString reason) {
+        if (auto failed = m_job->getFailedActions(); !failed.isEmpty() && failed.first())
+            m_status_code = failed.first()->replyStatusCode();
+        detach();
+        emitFailed(reason);
+    });
+    connect(m_job.get(), &Task::aborted, this, [this] {
+        detach();
+        emitAborted();
+    });
+    connect(m_job.get(), &Task::progress, this, &CachedApiRequest::setProgress);
+
+    if (!m_job->isRunning())
+        m_job->start();
+}
+
+void CachedApiRequest::readResponse()
+{
+    if (m_data) {
+        *m_response = *m_data;
+        detach();
+        emitSucceeded();
+        return;
+    }
+    QFile file(m_entry->getFullPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        detach();
+        emitFailed(tr("Failed to read the cached response for %1").arg(m_url.toString()));
+        return;
+    }
+    *m_response = file.readAll();
+    detach();
+    emitSucceeded();
+}
+
+void CachedApiRequest::detach()
+{
+    if (!m_job)
+        return;
+    disconnect(m_job.get(), nullptr, this, nullptr);
+
+    auto& requests = inFlight();
+    if (auto it = requests.find(m_key); it != requests.end() && it->job == m_job) {
+        // the last one waiting for a request stops it
+        if (--it->users == 0 && m_job->isRunning()) {
+            requests.erase(it);
+            m_job->abort();
+        }
+    }
+    m_job.reset();
+    m_entry.reset();
+    m_data.reset();
+}
+
+bool CachedApiRequest::abort()
+{
+    detach();
+    emitAborted();
+    return true;
+}
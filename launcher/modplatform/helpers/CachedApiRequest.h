@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QUrl>
+#include <memory>
+
+#include "net/HttpMetaCache.h"
+#include "net/NetJob.h"
+#include "tasks/Task.h"
+
+/**
+ * A GET request to a mod platform API whose response is kept in the HttpMetaCache.
+ *
+ * A stored response is used as is for time_to_live seconds. After that it is revalidated with the ETag and
+ * Last-Modified of the stored response, and when the request fails the stored response is used anyway,
+ * so pages that were seen before keep working offline.
+ * Identical requests that are already running are joined instead of being sent again.
+ *
+ * Searches (SEARCH_TTL) are too many and too short-lived to be stored: their responses are only kept in memory,
+ * and are not available offline.
+ *
+ * The response is written to the given byte array before succeeded() is emitted.
+ */
+class CachedApiRequest : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<CachedApiRequest>;
+
+    // lifetimes, in seconds, for the kinds of data the APIs return
+    static constexpr qint64 SEARCH_TTL = 5 * 60;
+    static constexpr qint64 VERSIONS_TTL = 10 * 60;
+    static constexpr qint64 PROJECT_TTL = 30 * 60;
+    static constexpr qint64 CATEGORIES_TTL = 24 * 60 * 60;
+
+    CachedApiRequest(QString name, QUrl url, std::shared_ptr<QByteArray> response, qint64 time_to_live);
+    ~CachedApiRequest() override;
+
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+    /** The HTTP status of the failed request, or -1 */
+    int replyStatusCode() const { return m_status_code; }
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void detach();
+    void readResponse();
+
+    QString m_name;
+    QUrl m_url;
+    QString m_key;
+    std::shared_ptr<QByteArray> m_response;
+    qint64 m_time_to_live;
+    int m_status_code = -1;
+
+    NetJob::Ptr m_job;
+    MetaEntryPtr m_entry;
+    std::shared_ptr<QByteArray> m_data;
+};
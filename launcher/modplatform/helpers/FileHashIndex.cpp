@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FileHashIndex.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+FileHashIndex::FileHashIndex(QString index_file) : m_index_file(index_file)
+{
+    if (!QFileInfo::exists(m_index_file))
+        return;
+
+    try {
+        auto doc = Json::requireDocument(m_index_file, "File hash index");
+        for (const QJsonValue& value : Json::requireArray(doc)) {
+            auto obj = Json::requireObject(value);
+
+            Entry entry;
+            entry.size = static_cast<qint64>(Json::requireDouble(obj, "size"));
+            entry.last_modified = static_cast<qint64>(Json::requireDouble(obj, "lastModified"));
+            auto hashes = Json::requireObject(obj, "hashes");
+            for (auto it = hashes.constBegin(); it != hashes.constEnd(); ++it)
+                entry.hashes.insert(it.key(), it.value().toString());
+
+            m_entries.insert(Json::requireString(obj, "path"), entry);
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Ignoring unreadable file hash index" << m_index_file << ":" << e.cause();
+        m_entries.clear();
+    }
+}
+
+std::optional<QString> FileHashIndex::hash(const QFileInfo& file, const QString& hash_type) const
+{
+    auto it = m_entries.constFind(file.absoluteFilePath());
+    if (it == m_entries.constEnd() || it->size != file.size() || it->last_modified != file.lastModified().toMSecsSinceEpoch())
+        return {};
+    auto hash = it->hashes.constFind(hash_type);
+    if (hash == it->hashes.constEnd())
+        return {};
+    return hash.value();
+}
+
+void FileHashIndex::insert(const QFileInfo& file, const QString& hash_type, const QString& hash)
+{
+    auto& entry = m_entries[file.absoluteFilePath()];
+    auto last_modified = file.lastModified().toMSecsSinceEpoch();
+    // the file changed, the other hashes are of its previous contents
+    if (entry.size != file.size() || entry.last_modified != last_modified) {
+        entry.size = file.size();
+        entry.last_modified = last_modified;
+        entry.hashes.clear();
+    }
+    entry.hashes.insert(hash_type, hash);
+    m_changed = true;
+}
+
+void FileHashIndex::save()
+{
+    QJsonArray entries;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!QFileInfo::exists(it.key())) {
+            it = m_entries.erase(it);
+            m_changed = true;
+            continue;
+        }
+
+        QJsonObject hashes;
+        for (auto hash = it->hashes.constBegin(); hash != it->hashes.constEnd(); ++hash)
+            hashes.insert(hash.key(), hash.value());
+
+        QJsonObject obj;
+        obj.insert("path", it.key());
+        obj.insert("size", it->size);
+        obj.insert("lastModified", it->last_modified);
+        obj.insert("hashes", hashes);
+        entries.append(obj);
+        ++it;
+    }
+
+    if (!m_changed)
+        return;
+
+    try {
+        Json::write(entries, m_index_file);
+        m_changed = false;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to save the file hash index" << m_index_file << ":" << e.cause();
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFileInfo>
+#include <QHash>
+#include <QString>
+#include <optional>
+
+/**
+ * Hashes of local files, stored by path together with the size and modification time the file had when it was hashed.
+ * A file that still has the same size and modification time is not hashed again.
+ *
+ * The index is kept in a file, so folders that are scanned over and over (e.g. the downloads folder) are only
+ * hashed once across runs.
+ */
+class FileHashIndex {
+   public:
+    explicit FileHashIndex(QString index_file);
+
+    /// the stored hash of the file, if it was hashed before and has not changed since
+    std::optional<QString> hash(const QFileInfo& file, const QString& hash_type) const;
+    void insert(const QFileInfo& file, const QString& hash_type, const QString& hash);
+
+    /// writes the index back to its file, without the files that no longer exist
+    void save();
+
+   private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 last_modified = 0;
+        QHash<QString, QString> hashes;
+    };
+
+    QString m_index_file;
+    QHash<QString, Entry> m_entries;
+    bool m_changed = false;
+};
@@ -5,12 +5,8 @@
 #include "NetworkResourceAPI.h"
 #include <memory>
 
-#include "Application.h"
-#include "net/NetJob.h"
-
 #include "modplatform/ModIndex.h"
-
-#include "net/ApiDownload.h"
+#include "modplatform/helpers/CachedApiRequest.h"
 
 Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&& callbacks) const
 {
@@ -23,9 +19,8 @@ Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&
     auto search_url = search_url_optional.value();
 
     auto response = std::make_shared<QByteArray>();
-    auto netJob = makeShared<NetJob>(QString("%1::Search").arg(debugName()), APPLICATION->network());
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(search_url), response));
+    auto netJob = makeShared<CachedApiRequest>(QString("%1::Search").arg(debugName()), QUrl(search_url), response,
+                                               CachedApiRequest::SEARCH_TTL);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks] {
         QJsonParseError parse_error{};
@@ -43,12 +38,8 @@ Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&
         callbacks.on_succeed(doc);
     });
 
-    QObject::connect(netJob.get(), &NetJob::failed, [netJob, callbacks](const QString& reason) {
-        int network_error_code = -1;
-        if (auto* failed_action = netJob->getFailedActions().at(0); failed_action)
-            network_error_code = failed_action->replyStatusCode();
-
-        callbacks.on_fail(reason, network_error_code);
+    QObject::connect(netJob.get(), &Task::failed, [netJob = netJob.get(), callbacks](const QString& reason) {
+        callbacks.on_fail(reason, netJob->replyStatusCode());
     });
     QObject::connect(netJob.get(), &NetJob::aborted, [callbacks] { callbacks.on_abort(); });
 
@@ -85,10 +76,9 @@ Task::Ptr NetworkResourceAPI::getProjectVersions(VersionSearchArgs&& args, Versi
 
     auto versions_url = versions_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::Versions").arg(args.pack.name), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto netJob = makeShared<CachedApiRequest>(QString("%1::Versions").arg(args.pack.name), QUrl(versions_url), response,
+                                               CachedApiRequest::VERSIONS_TTL);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [response, callbacks, args] {
         QJsonParseError parse_error{};
@@ -102,12 +92,8 @@ Task::Ptr NetworkResourceAPI::getProjectVersions(VersionSearchArgs&& args, Versi
 
         callbacks.on_succeed(doc, args.pack);
     });
-    QObject::connect(netJob.get(), &NetJob::failed, [netJob, callbacks](const QString& reason) {
-        int network_error_code = -1;
-        if (auto* failed_action = netJob->getFailedActions().at(0); failed_action)
-            network_error_code = failed_action->replyStatusCode();
-
-        callbacks.on_fail(reason, network_error_code);
+    QObject::connect(netJob.get(), &Task::failed, [netJob = netJob.get(), callbacks](const QString& reason) {
+        callbacks.on_fail(reason, netJob->replyStatusCode());
     });
 
     return netJob;
@@ -121,11 +107,7 @@ Task::Ptr NetworkResourceAPI::getProject(QString addonId, std::shared_ptr<QByteA
 
     auto project_url = project_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::GetProject").arg(addonId), APPLICATION->network());
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(project_url), response));
-
-    return netJob;
+    return makeShared<CachedApiRequest>(QString("%1::GetProject").arg(addonId), QUrl(project_url), response, CachedApiRequest::PROJECT_TTL);
 }
 
 Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args, DependencySearchCallbacks&& callbacks) const
@@ -136,10 +118,9 @@ Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args,
 
     auto versions_url = versions_url_optional.value();
 
-    auto netJob = makeShared<NetJob>(QString("%1::Dependency").arg(args.dependency.addonId.toString()), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
-
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto netJob = makeShared<CachedApiRequest>(QString("%1::Dependency").arg(args.dependency.addonId.toString()), QUrl(versions_url),
+                                               response, CachedApiRequest::VERSIONS_TTL);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [=] {
         QJsonParseError parse_error{};
@@ -153,12 +134,8 @@ Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args,
 
         callbacks.on_succeed(doc, args.dependency);
     });
-    QObject::connect(netJob.get(), &NetJob::failed, [netJob, callbacks](const QString& reason) {
-        int network_error_code = -1;
-        if (auto* failed_action = netJob->getFailedActions().at(0); failed_action)
-            network_error_code = failed_action->replyStatusCode();
-
-        callbacks.on_fail(reason, network_error_code);
+    QObject::connect(netJob.get(), &Task::failed, [netJob = netJob.get(), callbacks](const QString& reason) {
+        callbacks.on_fail(reason, netJob->replyStatusCode());
     });
     return netJob;
 }
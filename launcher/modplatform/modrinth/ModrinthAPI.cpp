@@ -6,6 +6,7 @@
 
 #include "Application.h"
 #include "Json.h"
+#include "modplatform/helpers/CachedApiRequest.h"
 #include "net/ApiDownload.h"
 #include "net/ApiUpload.h"
 #include "net/NetJob.h"
@@ -111,6 +112,16 @@ Task::Ptr ModrinthAPI::getProjects(QStringList addonIds, std::shared_ptr<QByteAr
     return netJob;
 }
 
+Task::Ptr ModrinthAPI::getVersions(const QStringList& versionIds, std::shared_ptr<QByteArray> response) const
+{
+    auto netJob = makeShared<NetJob>(QString("Modrinth::GetVersions"), APPLICATION->network());
+    auto searchUrl = getMultipleVersionInfoURL(versionIds);
+
+    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(searchUrl), response));
+
+    return netJob;
+}
+
 QList<ResourceAPI::SortingMethod> ModrinthAPI::getSortingMethods() const
 {
     // https://docs.modrinth.com/api-spec/#tag/projects/operation/searchProjects
@@ -123,8 +134,8 @@ QList<ResourceAPI::SortingMethod> ModrinthAPI::getSortingMethods() const
 
 Task::Ptr ModrinthAPI::getModCategories(std::shared_ptr<QByteArray> response)
 {
-    auto netJob = makeShared<NetJob>(QString("Modrinth::GetCategories"), APPLICATION->network());
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(BuildConfig.MODRINTH_PROD_URL + "/tag/category"), response));
+    auto netJob = makeShared<CachedApiRequest>(QString("Modrinth::GetCategories"), QUrl(BuildConfig.MODRINTH_PROD_URL + "/tag/category"),
+                                               response, CachedApiRequest::CATEGORIES_TTL);
     QObject::connect(netJob.get(), &Task::failed, [](QString msg) { qDebug() << "Modrinth failed to get categories:" << msg; });
     return netJob;
 }
@@ -29,6 +29,7 @@ class ModrinthAPI : public NetworkResourceAPI {
                         std::shared_ptr<QByteArray> response) -> Task::Ptr;
 
     Task::Ptr getProjects(QStringList addonIds, std::shared_ptr<QByteArray> response) const override;
+    Task::Ptr getVersions(const QStringList& versionIds, std::shared_ptr<QByteArray> response) const;
 
     static Task::Ptr getModCategories(std::shared_ptr<QByteArray> response);
     static QList<ModPlatform::Category> loadCategories(std::shared_ptr<QByteArray> response, QString projectType);
@@ -154,6 +155,11 @@ class ModrinthAPI : public NetworkResourceAPI {
         return BuildConfig.MODRINTH_PROD_URL + QString("/projects?ids=[\"%1\"]").arg(ids.join("\",\""));
     };
 
+    inline auto getMultipleVersionInfoURL(QStringList ids) const -> QString
+    {
+        return BuildConfig.MODRINTH_PROD_URL + QString("/versions?ids=[\"%1\"]").arg(ids.join("\",\""));
+    };
+
     inline auto getVersionsURL(VersionSearchArgs const& args) const -> std::optional<QString> override
     {
         QStringList get_arguments;
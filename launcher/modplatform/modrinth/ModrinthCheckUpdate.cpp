@@ -30,192 +30,219 @@ bool ModrinthCheckUpdate::abort()
 }
 
 /* Check for update:
- * - Get latest version available
+ * - Get latest version available, for every mod and loader at once
  * - Compare hash of the latest version with the current hash
  * - If equal, no updates, else, there's updates, so add to the list
  * */
 void ModrinthCheckUpdate::executeTask()
 {
     setStatus(tr("Preparing mods for Modrinth..."));
-    setProgress(0, 9);
+    setProgress(0, 2);
 
+    auto hash_types = ModPlatform::ProviderCapabilities::hashType(ModPlatform::ResourceProvider::MODRINTH);
     auto hashing_task =
         makeShared<ConcurrentTask>(this, "MakeModrinthHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
     for (auto* mod : m_mods) {
-        auto hash = mod->metadata()->hash;
+        auto hash_format = mod->metadata()->hash_format;
 
-        // Sadly the API can only handle one hash type per call, se we
-        // need to generate a new hash if the current one is innadequate
+        // The API can only handle one hash type per call, but the mods are grouped by hash type,
+        // so we only need to generate a new hash if the current one is not supported at all
         // (though it will rarely happen, if at all)
-        if (mod->metadata()->hash_format != m_hash_type) {
+        if (!hash_types.contains(hash_format)) {
             auto hash_task = Hashing::createHasher(mod->fileinfo().absoluteFilePath(), ModPlatform::ResourceProvider::MODRINTH);
-            connect(hash_task.get(), &Hashing::Hasher::resultsReady, [this, mod](QString hash) { m_mappings.insert(hash, mod); });
+            connect(hash_task.get(), &Hashing::Hasher::resultsReady,
+                    [this, mod](QString hash) { m_mappings.insert(hash, { mod, m_hash_type }); });
             connect(hash_task.get(), &Task::failed, [this] { failed("Failed to generate hash"); });
             hashing_task->addTask(hash_task);
         } else {
-            m_mappings.insert(hash, mod);
+            m_mappings.insert(mod->metadata()->hash, { mod, hash_format });
         }
     }
 
-    connect(hashing_task.get(), &Task::finished, this, &ModrinthCheckUpdate::checkNextLoader);
+    connect(hashing_task.get(), &Task::succeeded, this, &ModrinthCheckUpdate::getUpdateMods);
+    connect(hashing_task.get(), &Task::failed, this, &ModrinthCheckUpdate::getUpdateMods);
+    connect(hashing_task.get(), &Task::aborted, this, &ModrinthCheckUpdate::emitAborted);
     m_job = hashing_task;
     hashing_task->start();
 }
 
-void ModrinthCheckUpdate::checkVersionsResponse(std::shared_ptr<QByteArray> response,
-                                                ModPlatform::ModLoaderTypes loader,
-                                                bool forceModLoaderCheck)
+QList<ModPlatform::ModLoaderType> ModrinthCheckUpdate::candidateLoaders(Mod* mod) const
 {
-    QJsonParseError parse_error{};
-    QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError) {
-        qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
-                   << " reason: " << parse_error.errorString();
-        qWarning() << *response;
-
-        emitFailed(parse_error.errorString());
-        return;
+    auto loaders = m_loaders_list;
+    for (auto loader : m_fallback_loaders) {
+        if (mod->loaders() & loader)
+            loaders.append(loader);
     }
+    return loaders;
+}
 
-    setStatus(tr("Parsing the API response from Modrinth..."));
-    setProgress(m_next_loader_idx * 2, 9);
-
-    try {
-        for (auto hash : m_mappings.keys()) {
-            if (forceModLoaderCheck && !(m_mappings[hash]->loaders() & loader)) {
-                continue;
-            }
-            auto project_obj = doc[hash].toObject();
-
-            // If the returned project is empty, but we have Modrinth metadata,
-            // it means this specific version is not available
-            if (project_obj.isEmpty()) {
-                qDebug() << "Mod " << m_mappings.find(hash).value()->name() << " got an empty response." << "Hash: " << hash;
-
-                continue;
-            }
-
-            // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
-            // so we may want to filter it
-            QString loader_filter;
-            static auto flags = { ModPlatform::ModLoaderType::NeoForge, ModPlatform::ModLoaderType::Forge,
-                                  ModPlatform::ModLoaderType::Quilt, ModPlatform::ModLoaderType::Fabric };
-            for (auto flag : flags) {
-                if (loader.testFlag(flag)) {
-                    loader_filter = ModPlatform::getModLoaderAsString(flag);
-                    break;
-                }
-            }
-
-            // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
-            // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
-            // loader_filter
-            // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
-            // Such is the pain of having arbitrary files for a given version .-.
+QString ModrinthCheckUpdate::lookupKey(const QString& hash, ModPlatform::ModLoaderType loader) const
+{
+    return QString("modrinth/%1/%2/%3").arg(hash, QString::number(static_cast<int>(loader)), gameVersionsKey());
+}
 
-            auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, m_hash_type, loader_filter);
-            if (project_ver.downloadUrl.isEmpty()) {
-                qCritical() << "Modrinth mod without download url!" << project_ver.fileName;
+void ModrinthCheckUpdate::getUpdateMods()
+{
+    // Loaders the instance doesn't have are only tried for the mods that declare them
+    static auto flags = { ModPlatform::ModLoaderType::NeoForge, ModPlatform::ModLoaderType::Forge, ModPlatform::ModLoaderType::Quilt,
+                          ModPlatform::ModLoaderType::Fabric };
+    m_fallback_loaders.clear();
+    for (auto flag : flags) {
+        if (!m_loaders_list.contains(flag))
+            m_fallback_loaders.append(flag);
+    }
 
+    // Instead of waiting for a loader to answer before trying the next one, every loader is asked at once,
+    // with one call per hash type. The results are then used in order of preference.
+    auto job = makeShared<ConcurrentTask>(this, "ModrinthCheckUpdate", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    auto loaders = m_loaders_list + m_fallback_loaders;
+    int requests = 0;
+    for (auto loader : loaders) {
+        QHash<QString, QStringList> hashes_by_format;
+        for (auto it = m_mappings.cbegin(); it != m_mappings.cend(); ++it) {
+            if (!m_loaders_list.contains(loader) && !(it->mod->loaders() & loader))
                 continue;
-            }
-
-            auto mod_iter = m_mappings.find(hash);
-            if (mod_iter == m_mappings.end()) {
-                qCritical() << "Failed to remap mod from Modrinth!";
+            auto key = lookupKey(it.key(), loader);
+            if (auto cached = cachedLookup(key); cached.has_value()) {
+                m_results.insert(key, cached.value());
                 continue;
             }
-            auto mod = *mod_iter;
-            m_mappings.remove(hash);
-
-            auto key = project_ver.hash;
-
-            // Fake pack with the necessary info to pass to the download task :)
-            auto pack = std::make_shared<ModPlatform::IndexedPack>();
-            pack->name = mod->name();
-            pack->slug = mod->metadata()->slug;
-            pack->addonId = mod->metadata()->project_id;
-            pack->websiteUrl = mod->homeurl();
-            for (auto& author : mod->authors())
-                pack->authors.append({ author });
-            pack->description = mod->description();
-            pack->provider = ModPlatform::ResourceProvider::MODRINTH;
-            if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
-                if (mod->version() == project_ver.version_number)
-                    continue;
-
-                auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
-
-                m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.version_type,
-                                         project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task, mod->enabled());
-            }
-            m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
+            hashes_by_format[it->hash_format].append(it.key());
         }
-    } catch (Json::JsonException& e) {
-        emitFailed(e.cause() + " : " + e.what());
+        for (auto it = hashes_by_format.cbegin(); it != hashes_by_format.cend(); ++it) {
+            job->addTask(getUpdateModsForLoader(loader, it.key(), it.value()));
+            requests++;
+        }
+    }
+
+    if (requests == 0) {
+        checkResults();
         return;
     }
-    checkNextLoader();
+    qDebug() << "Checking" << m_mappings.size() << "mods for updates on Modrinth with" << requests << "request(s)";
+
+    setStatus(tr("Waiting for the API response from Modrinth..."));
+    setProgress(1, 2);
+
+    // A request that failed only means its loader isn't considered, like an empty response would
+    connect(job.get(), &Task::succeeded, this, &ModrinthCheckUpdate::checkResults);
+    connect(job.get(), &Task::failed, this, &ModrinthCheckUpdate::checkResults);
+    connect(job.get(), &Task::aborted, this, &ModrinthCheckUpdate::emitAborted);
+    m_job = job;
+    job->start();
 }
 
-void ModrinthCheckUpdate::getUpdateModsForLoader(ModPlatform::ModLoaderTypes loader, bool forceModLoaderCheck)
+Task::Ptr ModrinthCheckUpdate::getUpdateModsForLoader(ModPlatform::ModLoaderType loader,
+                                                      const QString& hash_format,
+                                                      const QStringList& hashes)
 {
     auto response = std::make_shared<QByteArray>();
-    QStringList hashes;
-    if (forceModLoaderCheck) {
-        for (auto hash : m_mappings.keys()) {
-            if (m_mappings[hash]->loaders() & loader) {
-                hashes.append(hash);
-            }
+    auto job = api.latestVersions(hashes, hash_format, m_game_versions, ModPlatform::ModLoaderTypes(loader), response);
+
+    connect(job.get(), &Task::succeeded, this, [this, response, loader, hashes] {
+        QJsonParseError parse_error{};
+        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
+                       << " reason: " << parse_error.errorString();
+            qWarning() << *response;
+            return;
         }
-    } else {
-        hashes = m_mappings.keys();
-    }
-    auto job = api.latestVersions(hashes, m_hash_type, m_game_versions, loader, response);
-
-    connect(job.get(), &Task::succeeded, this,
-            [this, response, loader, forceModLoaderCheck] { checkVersionsResponse(response, loader, forceModLoaderCheck); });
 
-    connect(job.get(), &Task::failed, this, &ModrinthCheckUpdate::checkNextLoader);
-
-    setStatus(tr("Waiting for the API response from Modrinth..."));
-    setProgress(m_next_loader_idx * 2 - 1, 9);
+        auto obj = doc.object();
+        for (auto& hash : hashes) {
+            // Empty results are kept too, so the next check knows to skip this loader without asking again
+            auto key = lookupKey(hash, loader);
+            auto project_obj = obj.value(hash).toObject();
+            m_results.insert(key, project_obj);
+            storeLookup(key, project_obj);
+        }
+    });
 
-    m_job = job;
-    job->start();
+    return job;
 }
 
-void ModrinthCheckUpdate::checkNextLoader()
+void ModrinthCheckUpdate::checkResults()
 {
-    if (m_mappings.isEmpty()) {
-        emitSucceeded();
-        return;
-    }
-    if (m_next_loader_idx < m_loaders_list.size()) {
-        getUpdateModsForLoader(m_loaders_list.at(m_next_loader_idx));
-        m_next_loader_idx++;
+    setStatus(tr("Parsing the API response from Modrinth..."));
+    setProgress(2, 2);
+
+    try {
+        for (auto it = m_mappings.cbegin(); it != m_mappings.cend(); ++it) {
+            bool found = false;
+            for (auto loader : candidateLoaders(it->mod)) {
+                // If the returned project is empty, but we have Modrinth metadata,
+                // it means this specific version is not available for this loader
+                auto project_obj = m_results.value(lookupKey(it.key(), loader));
+                if (!project_obj.isEmpty() && checkVersion(it->mod, it.key(), it->hash_format, project_obj, loader)) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                qDebug() << "Mod " << it->mod->name() << " got an empty response." << "Hash: " << it.key();
+                emit checkFailed(it->mod, tr("No valid version found for this mod. It's probably unavailable for the current game "
+                                             "version / mod loader."));
+            }
+        }
+    } catch (Json::JsonException& e) {
+        emitFailed(e.cause() + " : " + e.what());
         return;
     }
+    emitSucceeded();
+}
+
+bool ModrinthCheckUpdate::checkVersion(Mod* mod,
+                                       const QString& hash,
+                                       const QString& hash_format,
+                                       QJsonObject project_obj,
+                                       ModPlatform::ModLoaderType loader)
+{
+    // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
+    // so we may want to filter it
+    QString loader_filter;
     static auto flags = { ModPlatform::ModLoaderType::NeoForge, ModPlatform::ModLoaderType::Forge, ModPlatform::ModLoaderType::Quilt,
                           ModPlatform::ModLoaderType::Fabric };
     for (auto flag : flags) {
-        if (!m_loaders_list.contains(flag)) {
-            m_loaders_list.append(flag);
-            m_next_loader_idx++;
-            setProgress(m_next_loader_idx * 2 - 1, 9);
-            for (auto m : m_mappings) {
-                if (m->loaders() & flag) {
-                    getUpdateModsForLoader(flag, true);
-                    return;
-                }
-            }
-            setProgress(m_next_loader_idx * 2, 9);
+        if (loader == flag) {
+            loader_filter = ModPlatform::getModLoaderAsString(flag);
+            break;
         }
     }
-    for (auto m : m_mappings) {
-        emit checkFailed(m,
-                         tr("No valid version found for this mod. It's probably unavailable for the current game version / mod loader."));
+
+    // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
+    // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
+    // loader_filter
+    // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
+    // Such is the pain of having arbitrary files for a given version .-.
+
+    auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, hash_format, loader_filter);
+    if (project_ver.downloadUrl.isEmpty()) {
+        qCritical() << "Modrinth mod without download url!" << project_ver.fileName;
+        return false;
+    }
+
+    auto key = project_ver.hash;
+
+    // Fake pack with the necessary info to pass to the download task :)
+    auto pack = std::make_shared<ModPlatform::IndexedPack>();
+    pack->name = mod->name();
+    pack->slug = mod->metadata()->slug;
+    pack->addonId = mod->metadata()->project_id;
+    pack->websiteUrl = mod->homeurl();
+    for (auto& author : mod->authors())
+        pack->authors.append({ author });
+    pack->description = mod->description();
+    pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+    if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
+        if (mod->version() == project_ver.version_number)
+            return true;
+
+        auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
+
+        m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.version_type,
+                                 project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task, mod->enabled());
     }
-    emitSucceeded();
-    return;
+    m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
+    return true;
 }
@@ -16,13 +16,29 @@ class ModrinthCheckUpdate : public CheckUpdateTask {
 
    protected slots:
     void executeTask() override;
-    void getUpdateModsForLoader(ModPlatform::ModLoaderTypes loader, bool forceModLoaderCheck = false);
-    void checkVersionsResponse(std::shared_ptr<QByteArray> response, ModPlatform::ModLoaderTypes loader, bool forceModLoaderCheck = false);
-    void checkNextLoader();
+    void getUpdateMods();
+    void checkResults();
 
    private:
+    struct MappedMod {
+        Mod* mod;
+        QString hash_format;
+    };
+
+    Task::Ptr getUpdateModsForLoader(ModPlatform::ModLoaderType loader, const QString& hash_format, const QStringList& hashes);
+    bool checkVersion(Mod* mod,
+                      const QString& hash,
+                      const QString& hash_format,
+                      QJsonObject project_obj,
+                      ModPlatform::ModLoaderType loader);
+
+    /// the loaders to look for a mod's updates with, in order of preference
+    QList<ModPlatform::ModLoaderType> candidateLoaders(Mod* mod) const;
+    QString lookupKey(const QString& hash, ModPlatform::ModLoaderType loader) const;
+
     Task::Ptr m_job = nullptr;
-    QHash<QString, Mod*> m_mappings;
+    QHash<QString, MappedMod> m_mappings;
+    QList<ModPlatform::ModLoaderType> m_fallback_loaders;
+    QHash<QString, QJsonObject> m_results;
     QString m_hash_type;
-    int m_next_loader_idx = 0;
 };
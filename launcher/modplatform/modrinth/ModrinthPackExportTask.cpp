@@ -21,8 +21,9 @@
 #include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QFileInfo>
+#include <QHash>
 #include <QMessageBox>
-#include <QtConcurrentRun>
+#include <QtConcurrentMap>
 #include "Json.h"
 #include "MMCZip.h"
 #include "minecraft/PackProfile.h"
@@ -61,6 +62,11 @@ void ModrinthPackExportTask::executeTask()
 
 bool ModrinthPackExportTask::abort()
 {
+    if (hashFuture.isRunning()) {
+        hashFuture.cancel();
+        emitAborted();
+        return true;
+    }
     if (task) {
         task->abort();
         emitAborted();
@@ -93,9 +99,16 @@ void ModrinthPackExportTask::collectFiles()
 void ModrinthPackExportTask::collectHashes()
 {
     setStatus(tr("Finding file hashes..."));
-    for (const QFileInfo& file : files) {
-        QCoreApplication::processEvents();
 
+    // index the mods by path once instead of searching the whole list for every file
+    QHash<QString, const Mod*> modsByPath;
+    if (mcInstance) {
+        for (const Mod* mod : mcInstance->loaderModList()->allMods())
+            modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    }
+
+    QList<HashedFile> toHash;
+    for (const QFileInfo& file : files) {
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
         if (!std::any_of(PREFIXES.begin(), PREFIXES.end(), [&relative](const QString& prefix) { return relative.startsWith(prefix); }))
@@ -105,46 +118,98 @@ void ModrinthPackExportTask::collectHashes()
             }))
             continue;
 
-        QFile openFile(file.absoluteFilePath());
-        if (!openFile.open(QFile::ReadOnly)) {
-            qWarning() << "Could not open" << file << "for hashing";
-            continue;
+        HashedFile hashed{ relative, file.absoluteFilePath(), {}, {}, {}, file.size(), Metadata::ModSide::UniversalSide };
+
+        if (auto mod = modsByPath.value(file.absoluteFilePath()); mod && mod->metadata() != nullptr) {
+            const auto metadata = mod->metadata();
+            // reuse the digest recorded when the mod was downloaded
+            if (metadata->hash_format == "sha512")
+                hashed.sha512 = metadata->hash;
+            else if (metadata->hash_format == "sha1")
+                hashed.sha1 = metadata->hash;
+
+            // ensure the url is permitted on modrinth.com
+            const QUrl& url = metadata->url;
+            if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
+                hashed.url = url;
+                hashed.side = metadata->side;
+                hashed.resolveLocally = true;
+            }
         }
 
-        const QByteArray data = openFile.readAll();
-        if (openFile.error() != QFileDevice::NoError) {
-            qWarning() << "Could not read" << file;
+        toHash.append(hashed);
+    }
+
+    setAbortable(true);
+    connect(&hashWatcher, &QFutureWatcher<HashedFile>::progressValueChanged, this,
+            [this](int value) { setProgress(value, hashWatcher.progressMaximum()); });
+    connect(&hashWatcher, &QFutureWatcher<HashedFile>::finished, this, &ModrinthPackExportTask::hashesCollected);
+    hashFuture = QtConcurrent::mapped(toHash, &ModrinthPackExportTask::hashFile);
+    hashWatcher.setFuture(hashFuture);
+}
+
+ModrinthPackExportTask::HashedFile ModrinthPackExportTask::hashFile(HashedFile file)
+{
+    const bool needSha1 = file.resolveLocally && file.sha1.isEmpty();
+    const bool needSha512 = file.sha512.isEmpty();
+    if (!needSha1 && !needSha512)
+        return file;
+
+    QFile openFile(file.path);
+    if (!openFile.open(QFile::ReadOnly)) {
+        qWarning() << "Could not open" << file.path << "for hashing";
+        file.failed = true;
+        return file;
+    }
+
+    // read the file once in fixed size chunks, feeding every digest we need
+    constexpr int chunkSize = 1024 * 1024;
+    QCryptographicHash sha1(QCryptographicHash::Sha1);
+    QCryptographicHash sha512(QCryptographicHash::Sha512);
+    QByteArray buffer(chunkSize, Qt::Uninitialized);
+    qint64 read;
+    while ((read = openFile.read(buffer.data(), chunkSize)) > 0) {
+        const auto chunk = QByteArray::fromRawData(buffer.constData(), read);
+        if (needSha1)
+            sha1.addData(chunk);
+        if (needSha512)
+            sha512.addData(chunk);
+    }
+    if (read < 0) {
+        qWarning() << "Could not read" << file.path;
+        file.failed = true;
+        return file;
+    }
+
+    if (needSha1)
+        file.sha1 = sha1.result().toHex();
+    if (needSha512)
+        file.sha512 = sha512.result().toHex();
+    return file;
+}
+
+void ModrinthPackExportTask::hashesCollected()
+{
+    disconnect(&hashWatcher, nullptr, this, nullptr);
+    if (hashFuture.isCanceled())
+        return;
+
+    for (const HashedFile& file : hashFuture.results()) {
+        if (file.failed)
+            continue;
+
+        if (file.resolveLocally) {
+            qDebug() << "Resolving" << file.relative << "from index";
+            // nice! we've managed to resolve based on local metadata!
+            // no need to enqueue it
+            resolvedFiles[file.relative] = ResolvedFile{ file.sha1, file.sha512, file.url.toEncoded(), file.size, file.side };
             continue;
-        }
-        auto sha512 = Hashing::hash(data, Hashing::Algorithm::Sha512);
-
-        auto allMods = mcInstance->loaderModList()->allMods();
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (mod->metadata() != nullptr) {
-                QUrl& url = mod->metadata()->url;
-                // ensure the url is permitted on modrinth.com
-                if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
-                    qDebug() << "Resolving" << relative << "from index";
-
-                    auto sha1 = Hashing::hash(data, Hashing::Algorithm::Sha1);
-
-                    ResolvedFile resolvedFile{ sha1, sha512, url.toEncoded(), openFile.size(), mod->metadata()->side };
-                    resolvedFiles[relative] = resolvedFile;
-
-                    // nice! we've managed to resolve based on local metadata!
-                    // no need to enqueue it
-                    continue;
-                }
-            }
         }
 
-        qDebug() << "Enqueueing" << relative << "for Modrinth query";
-        pendingHashes[relative] = sha512;
+        qDebug() << "Enqueueing" << file.relative << "for Modrinth query";
+        pendingHashes[file.relative] = file.sha512;
     }
 
-    setAbortable(true);
     makeApiRequest();
 }
 
@@ -169,23 +234,27 @@ void ModrinthPackExportTask::parseApiResponse(const std::shared_ptr<QByteArray>
     try {
         const QJsonDocument doc = Json::requireDocument(*response);
 
+        // every file of every returned version by its hash, a version can have more files than the one we asked for
+        QHash<QString, QJsonObject> filesByHash;
+        const QJsonObject versions = doc.object();
+        for (auto version = versions.constBegin(); version != versions.constEnd(); ++version) {
+            for (auto file : version->toObject()["files"].toArray()) {
+                auto fileObj = file.toObject();
+                filesByHash.insert(fileObj["hashes"].toObject()["sha512"].toString(), fileObj);
+            }
+        }
+
         QMapIterator<QString, QString> iterator(pendingHashes);
         while (iterator.hasNext()) {
             iterator.next();
 
-            const QJsonObject obj = doc[iterator.value()].toObject();
-            if (obj.isEmpty())
+            auto fileIter = filesByHash.constFind(iterator.value());
+            if (fileIter == filesByHash.constEnd())
                 continue;
 
-            const QJsonArray files_array = obj["files"].toArray();
-            if (auto fileIter = std::find_if(files_array.begin(), files_array.end(),
-                                             [&iterator](const QJsonValue& file) { return file["hashes"]["sha512"] == iterator.value(); });
-                fileIter != files_array.end()) {
-                // map the file to the url
-                resolvedFiles[iterator.key()] =
-                    ResolvedFile{ fileIter->toObject()["hashes"].toObject()["sha1"].toString(), iterator.value(),
-                                  fileIter->toObject()["url"].toString(), fileIter->toObject()["size"].toInt() };
-            }
+            // map the file to the url
+            resolvedFiles[iterator.key()] = ResolvedFile{ (*fileIter)["hashes"].toObject()["sha1"].toString(), iterator.value(),
+                                                          (*fileIter)["url"].toString(), (*fileIter)["size"].toInt() };
         }
     } catch (const Json::JsonException& e) {
         emitFailed(tr("Failed to parse versions response: %1").arg(e.what()));
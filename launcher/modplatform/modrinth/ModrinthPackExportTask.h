@@ -48,6 +48,17 @@ class ModrinthPackExportTask : public Task {
         Metadata::ModSide side;
     };
 
+    struct HashedFile {
+        QString relative, path;
+        QString sha1, sha512;
+        QUrl url;
+        qint64 size;
+        Metadata::ModSide side;
+        // the file has a permitted download url in its metadata and needs no API lookup
+        bool resolveLocally = false;
+        bool failed = false;
+    };
+
     static const QStringList PREFIXES;
     static const QStringList FILE_EXTENSIONS;
 
@@ -65,9 +76,13 @@ class ModrinthPackExportTask : public Task {
     QMap<QString, QString> pendingHashes;
     QMap<QString, ResolvedFile> resolvedFiles;
     Task::Ptr task;
+    QFuture<HashedFile> hashFuture;
+    QFutureWatcher<HashedFile> hashWatcher;
 
     void collectFiles();
     void collectHashes();
+    void hashesCollected();
+    static HashedFile hashFile(HashedFile file);
     void makeApiRequest();
     void parseApiResponse(std::shared_ptr<QByteArray> response);
     void buildZip();
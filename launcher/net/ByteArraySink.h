@@ -36,6 +36,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "Sink.h"
 
 namespace Net {
@@ -61,7 +63,35 @@ class ByteArraySink : public Sink {
         return Task::State::Failed;
     };
 
-    auto write(QByteArray& data) -> Task::State override
+    auto headersReceived(QNetworkReply& reply) -> Task::State override
+    {
+        // size the buffer once, instead of growing it with every chunk
+        bool ok = false;
+        auto length = reply.header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+        if (m_output && ok && length > 0)
+            m_output->reserve(static_cast<int>(std::min(length, MAX_RESERVE)));
+        return Task::State::Running;
+    }
+
+    auto writeFrom(QIODevice& device) -> Task::State override
+    {
+        auto available = device.bytesAvailable();
+        if (!m_output || available <= 0)
+            return Sink::writeFrom(device);
+
+        // read straight into the output, the validators look at the new part of it
+        auto offset = m_output->size();
+        m_output->resize(offset + static_cast<int>(available));
+        auto read = device.read(m_output->data() + offset, available);
+        m_output->resize(offset + static_cast<int>(std::max<qint64>(read, 0)));
+        if (read < 0)
+            return Task::State::Failed;
+        if (writeAllValidators(QByteArray::fromRawData(m_output->constData() + offset, static_cast<int>(read))))
+            return Task::State::Running;
+        return Task::State::Failed;
+    }
+
+    auto write(const QByteArray& data) -> Task::State override
     {
         if (m_output)
             m_output->append(data);
@@ -88,6 +118,9 @@ class ByteArraySink : public Sink {
     auto hasLocalData() -> bool override { return false; }
 
    private:
+    // don't trust the server with more than this up front
+    static constexpr qint64 MAX_RESERVE = 64 * 1024 * 1024;
+
     std::shared_ptr<QByteArray> m_output;
 };
 }  // namespace Net
@@ -57,7 +57,7 @@ class ChecksumValidator : public Validator {
         return true;
     }
 
-    auto write(QByteArray& data) -> bool override
+    auto write(const QByteArray& data) -> bool override
     {
         m_checksum.addData(data);
         return true;
@@ -35,6 +35,10 @@
 
 #include "FileSink.h"
 
+#include <QFileInfo>
+
+#include <algorithm>
+
 #include "FileSystem.h"
 
 #include "net/Logging.h"
@@ -48,17 +52,41 @@ Task::State FileSink::init(QNetworkRequest& request)
         return result;
     }
 
-    // create a new save file and open it for writing
+    // create the folder for the file and its partial download
     if (!FS::ensureFilePathExists(m_filename)) {
         qCCritical(taskNetLogC) << "Could not create folder for " + m_filename;
         return Task::State::Failed;
     }
 
     wroteAnyData = false;
-    m_output_file.reset(new QSaveFile(m_filename));
-    if (!m_output_file->open(QIODevice::WriteOnly)) {
-        qCCritical(taskNetLogC) << "Could not open " + m_filename + " for writing";
-        return Task::State::Failed;
+    m_discard_body = false;
+    m_resume_offset = 0;
+    m_output_file.reset();
+    m_buffer.clear();
+
+    // conditional requests are about the complete file, don't mix them with a partial one
+    if (!request.hasRawHeader("If-None-Match") && !request.hasRawHeader("If-Modified-Since")) {
+        QFileInfo part(partFilename());
+        QFile resumeInfo(resumeInfoFilename());
+        if (part.isFile() && part.size() > 0 && resumeInfo.open(QIODevice::ReadOnly)) {
+            // the validator, then the size of the whole file if it is known
+            auto lines = resumeInfo.readAll().split('\n');
+            resumeInfo.close();
+            auto validator = lines.value(0).trimmed();
+            auto total = lines.value(1).trimmed().toLongLong();
+            if (total > 0 && part.size() >= total) {
+                // there is nothing left to ask for, the server would refuse the range on every attempt
+                qCDebug(taskNetLogC) << "Partial download of" << m_filename << "is not smaller than the file, starting over";
+                discardPartial();
+            } else if (!validator.isEmpty()) {
+                m_resume_offset = part.size();
+                qCDebug(taskNetLogC) << "Resuming" << m_filename << "from byte" << m_resume_offset;
+                request.setRawHeader("Range", "bytes=" + QByteArray::number(m_resume_offset) + "-");
+                request.setRawHeader("If-Range", validator);
+                // offsets must refer to the stored bytes, not to a compressed transfer
+                request.setRawHeader("Accept-Encoding", "identity");
+            }
+        }
     }
 
     if (initAllValidators(request))
@@ -66,23 +94,122 @@ Task::State FileSink::init(QNetworkRequest& request)
     return Task::State::Failed;
 }
 
-Task::State FileSink::write(QByteArray& data)
+Task::State FileSink::headersReceived(QNetworkReply& reply)
 {
-    if (!writeAllValidators(data) || m_output_file->write(data) != data.size()) {
-        qCCritical(taskNetLogC) << "Failed writing into " + m_filename;
-        m_output_file->cancelWriting();
+    bool validStatus = false;
+    int statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(&validStatus);
+
+    bool resuming = false;
+    if (validStatus && statusCode == 206) {
+        // Content-Range: bytes <start>-<end>/<total>
+        auto range = reply.rawHeader("Content-Range");
+        auto start = range.mid(range.indexOf(' ') + 1).split('-').first().trimmed();
+        if (m_resume_offset == 0 || start.toLongLong() != m_resume_offset) {
+            qCCritical(taskNetLogC) << "Unexpected range" << range << "for" << m_filename;
+            discardPartial();
+            return Task::State::Failed;
+        }
+        resuming = true;
+    } else if (validStatus && statusCode != 200 && statusCode != 203) {
+        if (m_resume_offset > 0 && statusCode >= 400 && statusCode < 500) {
+            // the server won't continue this partial (e.g. 416 Range Not Satisfiable), and would refuse it again on
+            // every retry, so the next attempt asks for the whole file
+            qCWarning(taskNetLogC) << "Server refused to resume" << m_filename << "with status" << statusCode << ", dropping the partial";
+            discardPartial();
+            m_resume_offset = 0;
+        }
+        // redirects, 304 Not Modified and errors don't carry the file, keep any partial data for later
+        m_discard_body = true;
+        return Task::State::Running;
+    } else if (m_resume_offset > 0) {
+        qCDebug(taskNetLogC) << "Server sent the whole file, restarting" << m_filename;
+        m_resume_offset = 0;
+    }
+
+    if (resuming && !resumeValidators()) {
+        qCCritical(taskNetLogC) << "Could not read back the partial download of" << m_filename;
+        discardPartial();
+        return Task::State::Failed;
+    }
+
+    m_output_file.reset(new QFile(partFilename()));
+    // writes go through our own buffer, don't copy them again into the one of QFile
+    auto mode = resuming ? QIODevice::WriteOnly | QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate;
+    mode |= QIODevice::Unbuffered;
+    if (!m_output_file->open(mode)) {
+        qCCritical(taskNetLogC) << "Could not open " + partFilename() + " for writing";
         m_output_file.reset();
-        wroteAnyData = false;
         return Task::State::Failed;
     }
+    wroteAnyData = resuming;
+    m_buffer.clear();
+    m_buffer.reserve(WRITE_BUFFER_SIZE);
+
+    saveResumeInfo(reply, resuming);
+    return Task::State::Running;
+}
+
+Task::State FileSink::write(const QByteArray& data)
+{
+    if (m_discard_body)
+        return Task::State::Running;
+
+    if (!m_output_file || !writeAllValidators(data))
+        return failWrite();
+
+    if (m_buffer.size() + data.size() > WRITE_BUFFER_SIZE && !flushBuffer())
+        return failWrite();
+    if (data.size() >= WRITE_BUFFER_SIZE) {
+        if (m_output_file->write(data) != data.size())
+            return failWrite();
+    } else {
+        m_buffer.append(data);
+    }
 
     wroteAnyData = true;
     return Task::State::Running;
 }
 
+Task::State FileSink::writeFrom(QIODevice& device)
+{
+    if (m_discard_body) {
+        device.readAll();
+        return Task::State::Running;
+    }
+    if (!m_output_file)
+        return failWrite();
+
+    while (device.bytesAvailable() > 0) {
+        if (m_buffer.size() == WRITE_BUFFER_SIZE && !flushBuffer())
+            return failWrite();
+
+        // read straight into the free part of the buffer, the validators look at what was just read
+        auto offset = m_buffer.size();
+        auto wanted = std::min<qint64>(device.bytesAvailable(), WRITE_BUFFER_SIZE - offset);
+        m_buffer.resize(offset + static_cast<int>(wanted));
+        auto read = device.read(m_buffer.data() + offset, wanted);
+        m_buffer.resize(offset + static_cast<int>(std::max<qint64>(read, 0)));
+        if (read < 0)
+            return failWrite();
+        if (read == 0)
+            break;
+        if (!writeAllValidators(QByteArray::fromRawData(m_buffer.constData() + offset, static_cast<int>(read))))
+            return failWrite();
+        wroteAnyData = true;
+    }
+    return Task::State::Running;
+}
+
 Task::State FileSink::abort()
 {
-    m_output_file->cancelWriting();
+    if (m_output_file) {
+        // keep what we have if we know how to continue it later
+        flushBuffer();
+        m_output_file->close();
+        m_output_file.reset();
+        if (!QFile::exists(resumeInfoFilename()))
+            QFile::remove(partFilename());
+    }
     failAllValidators();
     return Task::State::Failed;
 }
@@ -95,26 +222,32 @@ Task::State FileSink::finalize(QNetworkReply& reply)
     int statusCode = statusCodeV.toInt(&validStatus);
     if (validStatus) {
         // this leaves out 304 Not Modified
-        gotFile = statusCode == 200 || statusCode == 203;
+        gotFile = statusCode == 200 || statusCode == 203 || statusCode == 206;
     }
 
-    // if we wrote any data to the save file, we try to commit the data to the real file.
+    // if we wrote any data to the partial file, we try to move it to the real file.
     // if it actually got a proper file, we write it even if it was empty
-    if (gotFile || wroteAnyData) {
+    if ((gotFile || wroteAnyData) && m_output_file) {
         // ask validators for data consistency
         // we only do this for actual downloads, not 'your data is still the same' cache hits
-        if (!finalizeAllValidators(reply))
+        if (!finalizeAllValidators(reply)) {
+            // don't resume from data that turned out to be bad
+            discardPartial();
             return Task::State::Failed;
+        }
 
         // nothing went wrong...
-        if (!m_output_file->commit()) {
+        auto flushed = flushBuffer();
+        m_output_file->close();
+        if (!flushed || m_output_file->error() != QFileDevice::NoError || !FS::move(partFilename(), m_filename)) {
             qCCritical(taskNetLogC) << "Failed to commit changes to " << m_filename;
-            m_output_file->cancelWriting();
+            discardPartial();
             return Task::State::Failed;
         }
+        QFile::remove(resumeInfoFilename());
     }
 
-    // then get rid of the save file
+    // then get rid of the partial file handle
     m_output_file.reset();
 
     return finalizeCache(reply);
@@ -135,4 +268,79 @@ bool FileSink::hasLocalData()
     QFileInfo info(m_filename);
     return info.exists() && info.size() != 0;
 }
+
+bool FileSink::resumeValidators()
+{
+    QFile part(partFilename());
+    if (!part.open(QIODevice::ReadOnly) || part.size() != m_resume_offset)
+        return false;
+
+    constexpr qint64 chunkSize = 1024 * 1024;
+    while (!part.atEnd()) {
+        auto chunk = part.read(chunkSize);
+        if (chunk.isEmpty() || !writeAllValidators(chunk))
+            return false;
+    }
+    return true;
+}
+
+void FileSink::saveResumeInfo(QNetworkReply& reply, bool resuming)
+{
+    // If-Range only accepts strong ETags, otherwise fall back to the modification date
+    QByteArray validator = reply.rawHeader("ETag");
+    if (validator.isEmpty() || validator.startsWith("W/"))
+        validator = reply.rawHeader("Last-Modified");
+
+    if (validator.isEmpty()) {
+        QFile::remove(resumeInfoFilename());
+        return;
+    }
+
+    // lets the next attempt tell whether the partial file still has anything missing
+    qint64 total = 0;
+    if (resuming) {
+        auto range = reply.rawHeader("Content-Range");
+        total = range.mid(range.lastIndexOf('/') + 1).trimmed().toLongLong();
+    } else {
+        // a compressed transfer is decoded on the fly, its length is not the one of the stored file
+        auto encoding = reply.rawHeader("Content-Encoding").trimmed();
+        if (encoding.isEmpty() || encoding == "identity")
+            total = reply.header(QNetworkRequest::ContentLengthHeader).toLongLong();
+    }
+    if (total > 0)
+        validator += "\n" + QByteArray::number(total);
+
+    QFile resumeInfo(resumeInfoFilename());
+    if (!resumeInfo.open(QIODevice::WriteOnly | QIODevice::Truncate) || resumeInfo.write(validator) != validator.size())
+        qCWarning(taskNetLogC) << "Could not save resume information for" << m_filename;
+}
+
+bool FileSink::flushBuffer()
+{
+    if (m_buffer.isEmpty())
+        return true;
+    auto written = m_output_file && m_output_file->write(m_buffer) == m_buffer.size();
+    // keeps the capacity reserved for the next chunks
+    m_buffer.resize(0);
+    return written;
+}
+
+Task::State FileSink::failWrite()
+{
+    qCCritical(taskNetLogC) << "Failed writing into " + m_filename;
+    discardPartial();
+    wroteAnyData = false;
+    return Task::State::Failed;
+}
+
+void FileSink::discardPartial()
+{
+    m_buffer.clear();
+    if (m_output_file) {
+        m_output_file->close();
+        m_output_file.reset();
+    }
+    QFile::remove(partFilename());
+    QFile::remove(resumeInfoFilename());
+}
 }  // namespace Net
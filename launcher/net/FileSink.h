@@ -35,11 +35,21 @@
 
 #pragma once
 
-#include <QSaveFile>
+#include <QFile>
 
 #include "Sink.h"
 
 namespace Net {
+/*
+ * Sink that downloads into a file.
+ *
+ * Data is written to a '.part' file next to the target, which only replaces the target once the download
+ * is complete and validated. When the server identifies the content with a strong ETag or a Last-Modified
+ * date, the partial file is kept across failures and later attempts continue it with a Range request.
+ *
+ * The reply is read into a large buffer that is written out whenever it fills up, so the file sees a few big
+ * writes instead of one per network chunk.
+ */
 class FileSink : public Sink {
    public:
     FileSink(QString filename) : m_filename(filename) {};
@@ -47,7 +57,9 @@ class FileSink : public Sink {
 
    public:
     auto init(QNetworkRequest& request) -> Task::State override;
-    auto write(QByteArray& data) -> Task::State override;
+    auto headersReceived(QNetworkReply& reply) -> Task::State override;
+    auto write(const QByteArray& data) -> Task::State override;
+    auto writeFrom(QIODevice& device) -> Task::State override;
     auto abort() -> Task::State override;
     auto finalize(QNetworkReply& reply) -> Task::State override;
 
@@ -57,9 +69,28 @@ class FileSink : public Sink {
     virtual auto initCache(QNetworkRequest&) -> Task::State;
     virtual auto finalizeCache(QNetworkReply& reply) -> Task::State;
 
+   private:
+    auto partFilename() const -> QString { return m_filename + ".part"; }
+    auto resumeInfoFilename() const -> QString { return m_filename + ".part.resume"; }
+
+    /// feeds the data already in the partial file to the validators
+    auto resumeValidators() -> bool;
+    /// remembers how to continue the file later, and how large it will be once complete
+    void saveResumeInfo(QNetworkReply& reply, bool resuming);
+    void discardPartial();
+    auto flushBuffer() -> bool;
+    auto failWrite() -> Task::State;
+
    protected:
     QString m_filename;
     bool wroteAnyData = false;
-    std::unique_ptr<QSaveFile> m_output_file;
+    std::unique_ptr<QFile> m_output_file;
+
+   private:
+    static constexpr int WRITE_BUFFER_SIZE = 1024 * 1024;
+
+    QByteArray m_buffer;
+    qint64 m_resume_offset = 0;
+    bool m_discard_body = false;
 };
 }  // namespace Net
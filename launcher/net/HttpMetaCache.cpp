@@ -127,10 +127,15 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
     // Get rid of old entries, to prevent cache problems
     auto current_time = QDateTime::currentSecsSinceEpoch();
     if (entry->isExpired(current_time - (file_last_changed / 1000))) {
-        qCWarning(taskNetLogC) << "[HttpMetaCache]"
-                               << "Removing cache entry because of old age!";
-        selected_base.entry_list.remove(resource_path);
-        return staleEntry(base, resource_path);
+        if (!selected_base.revalidate) {
+            qCWarning(taskNetLogC) << "[HttpMetaCache]"
+                                   << "Removing cache entry because of old age!";
+            selected_base.entry_list.remove(resource_path);
+            return staleEntry(base, resource_path);
+        }
+        // keep the ETag and Last-Modified around, the request can then revalidate the file instead of downloading it again
+        qCDebug(taskHttpMetaCacheLogC) << "Revalidating expired cache entry" << real_path;
+        entry->m_stale = true;
     }
 
     // entry passed all the checks we cared about.
@@ -191,7 +196,7 @@ auto HttpMetaCache::staleEntry(QString base, QString resource_path) -> MetaEntry
     return MetaEntryPtr(foo);
 }
 
-void HttpMetaCache::addBase(QString base, QString base_root)
+void HttpMetaCache::addBase(QString base, QString base_root, bool revalidate)
 {
     // TODO: report error
     if (m_entries.contains(base))
@@ -200,6 +205,7 @@ void HttpMetaCache::addBase(QString base, QString base_root)
     // TODO: check if the base path is valid
     EntryMap foo;
     foo.base_path = base_root;
+    foo.revalidate = revalidate;
     m_entries[base] = foo;
 }
 
@@ -76,6 +76,10 @@ class MetaEntry {
 
     bool isExpired(qint64 offset) { return !m_is_eternal && (m_current_age >= m_max_age - offset); }
 
+    /* Lifetime (in seconds) to use instead of the server's caching headers the next time the entry is refreshed. */
+    auto getTimeToLive() -> qint64 { return m_time_to_live; }
+    void setTimeToLive(qint64 seconds) { m_time_to_live = seconds; }
+
    protected:
     QString m_baseId;
     QString m_basePath;
@@ -88,6 +92,7 @@ class MetaEntry {
     qint64 m_current_age = 0;
     qint64 m_max_age = 0;
     bool m_is_eternal = false;
+    qint64 m_time_to_live = 0;
 
     bool m_stale = true;
 };
@@ -115,7 +120,8 @@ class HttpMetaCache : public QObject {
     auto evictEntry(MetaEntryPtr entry) -> bool;
     void evictAll();
 
-    void addBase(QString base, QString base_root);
+    // entries of a revalidating base keep their validators once expired, instead of being dropped
+    void addBase(QString base, QString base_root, bool revalidate = false);
 
     // (re)start a timer that calls SaveNow later.
     void SaveEventually();
@@ -132,6 +138,7 @@ class HttpMetaCache : public QObject {
 
     struct EntryMap {
         QString base_path;
+        bool revalidate = false;
         QMap<QString, MetaEntryPtr> entry_list;
     };
 
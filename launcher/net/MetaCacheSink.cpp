@@ -38,6 +38,7 @@
 #include <QFileInfo>
 #include <QRegularExpression>
 #include "Application.h"
+#include "FileSystem.h"
 
 #include "net/Logging.h"
 
@@ -76,6 +77,10 @@ Task::State MetaCacheSink::initCache(QNetworkRequest& request)
 
 Task::State MetaCacheSink::finalizeCache(QNetworkReply& reply)
 {
+    if (reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        // the stored file was revalidated, its age starts over
+        FS::updateTimestamp(m_filename);
+    }
     QFileInfo output_file_info(m_filename);
 
     if (wroteAnyData) {
@@ -94,6 +99,8 @@ Task::State MetaCacheSink::finalizeCache(QNetworkReply& reply)
         if (m_is_eternal) {
             qCDebug(taskMetaCacheLogC) << "Adding eternal cache entry:" << m_entry->getFullPath();
             m_entry->makeEternal(true);
+        } else if (m_entry->getTimeToLive() > 0) {
+            m_entry->setMaximumAge(m_entry->getTimeToLive());
         } else if (reply.hasRawHeader("Cache-Control")) {
             auto cache_control_header = reply.rawHeader("Cache-Control");
             qCDebug(taskMetaCacheLogC) << "Parsing 'Cache-Control' header with" << cache_control_header;
@@ -38,7 +38,12 @@
 #include "NetJob.h"
 #include <QNetworkReply>
 #include "net/NetRequest.h"
+#include "net/NetworkScheduler.h"
 #include "tasks/ConcurrentTask.h"
+
+#include <limits>
+#include <memory>
+
 #if defined(LAUNCHER_APPLICATION)
 #include "Application.h"
 #include "ui/dialogs/CustomMessageBox.h"
@@ -47,23 +52,44 @@
 NetJob::NetJob(QString job_name, shared_qobject_ptr<QNetworkAccessManager> network, int max_concurrent)
     : ConcurrentTask(nullptr, job_name), m_network(network)
 {
+    auto scheduler = Net::NetworkScheduler::instance();
 #if defined(LAUNCHER_APPLICATION)
-    if (max_concurrent < 0)
-        max_concurrent = APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt();
+    scheduler->setBaseLimit(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt());
 #endif
-    if (max_concurrent > 0)
-        setMaxConcurrent(max_concurrent);
+    // the per-host limits of the scheduler do the throttling, unless the caller asked for a hard cap
+    setMaxConcurrent(max_concurrent > 0 ? max_concurrent : std::numeric_limits<int>::max());
+
+    connect(scheduler, &Net::NetworkScheduler::capacityAvailable, this, [this] {
+        if (isRunning() && !m_queue.isEmpty())
+            QMetaObject::invokeMethod(this, &NetJob::executeNextSubTask, Qt::QueuedConnection);
+    });
+    connect(this, &Task::finished, this, [this] { Net::NetworkScheduler::instance()->forgetJob(this); });
+}
+
+NetJob::~NetJob()
+{
+    Net::NetworkScheduler::instance()->forgetJob(this);
 }
 
 auto NetJob::addNetAction(Net::NetRequest::Ptr action) -> bool
 {
     action->setNetwork(m_network);
 
+    auto host = action->url().host();
+    m_hosts.insert(action.get(), host);
+    m_queued_per_host[host]++;
+
     addTask(action);
 
     return true;
 }
 
+void NetJob::executeTask()
+{
+    // executeNextSubTask fills every free slot by itself
+    QMetaObject::invokeMethod(this, &NetJob::executeNextSubTask, Qt::QueuedConnection);
+}
+
 void NetJob::executeNextSubTask()
 {
     // We're finished, check for failures and retry if we can (up to 3 times)
@@ -73,9 +99,68 @@ void NetJob::executeNextSubTask()
             auto task = m_failed.take(*m_failed.keyBegin());
             m_done.remove(task.get());
             m_queue.enqueue(task);
+            m_queued_per_host[m_hosts.value(task.get())]++;
         }
     }
-    ConcurrentTask::executeNextSubTask();
+
+    if (!isRunning() || m_queue.isEmpty()) {
+        // let ConcurrentTask decide whether we are done
+        ConcurrentTask::executeNextSubTask();
+        return;
+    }
+
+    // start as much as the scheduler lets us, the rest is picked up when capacity frees up
+    while (m_doing.count() < m_total_max_size && startNextScheduledTask()) {
+    }
+}
+
+bool NetJob::startNextScheduledTask()
+{
+    auto scheduler = Net::NetworkScheduler::instance();
+
+    QSet<QString> blocked;
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+        auto host = m_hosts.value(it->get());
+        if (blocked.contains(host))
+            continue;
+
+        if (!scheduler->tryAcquire(host, this)) {
+            blocked.insert(host);
+            // every host we still have work for is busy
+            if (blocked.size() >= m_queued_per_host.size())
+                return false;
+            continue;
+        }
+
+        auto task = *it;
+        m_queue.erase(it);
+        if (--m_queued_per_host[host] <= 0)
+            m_queued_per_host.remove(host);
+
+        // the slot is returned when the request ends, however this job ends up
+        auto finishedConnection = std::make_shared<QMetaObject::Connection>();
+        auto destroyedConnection = std::make_shared<QMetaObject::Connection>();
+        auto release = [scheduler, host, job = static_cast<const void*>(this), request = task.get(), finishedConnection,
+                        destroyedConnection] {
+            // only once, and without leaving connections behind for the next try of the request
+            QObject::disconnect(*finishedConnection);
+            QObject::disconnect(*destroyedConnection);
+            Net::NetworkScheduler::Sample sample;
+            if (auto netRequest = qobject_cast<Net::NetRequest*>(request)) {
+                sample.succeeded = netRequest->wasSuccessful();
+                sample.http2 = netRequest->usedHttp2();
+                sample.bytes = netRequest->bytesReceived();
+                sample.timeToFirstByteMs = netRequest->timeToFirstByte();
+            }
+            scheduler->release(host, job, sample);
+        };
+        *finishedConnection = connect(task.get(), &Task::finished, scheduler, release);
+        *destroyedConnection = connect(task.get(), &QObject::destroyed, scheduler, release);
+
+        startSubTask(task);
+        return true;
+    }
+    return false;
 }
 
 auto NetJob::size() const -> int
@@ -106,6 +191,7 @@ auto NetJob::abort() -> bool
     for (auto task : m_queue)
         m_failed.insert(task.get(), task);
     m_queue.clear();
+    m_queued_per_host.clear();
 
     // abort active downloads
     auto toKill = m_doing.values();
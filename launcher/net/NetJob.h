@@ -52,8 +52,12 @@ class NetJob : public ConcurrentTask {
    public:
     using Ptr = shared_qobject_ptr<NetJob>;
 
+    /**
+     * Requests are scheduled per host through the shared Net::NetworkScheduler.
+     * A positive max_concurrent additionally caps how many requests this job runs at once.
+     */
     explicit NetJob(QString job_name, shared_qobject_ptr<QNetworkAccessManager> network, int max_concurrent = -1);
-    ~NetJob() override = default;
+    ~NetJob() override;
 
     auto size() const -> int;
 
@@ -70,15 +74,25 @@ class NetJob : public ConcurrentTask {
     void emitFailed(QString reason) override;
 
    protected slots:
+    void executeTask() override;
     void executeNextSubTask() override;
 
    protected:
     void updateState() override;
     bool isOnline();
 
+   private:
+    /// starts the first queued request whose host has a free slot, returns false if there is none
+    bool startNextScheduledTask();
+
    private:
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
+    /// host of every request, as it was when the request was added
+    QHash<Task*, QString> m_hosts;
+    /// how many queued requests each host has, hosts without any are left out
+    QHash<QString, int> m_queued_per_host;
+
     int m_try = 1;
     bool m_ask_retry = true;
     int m_manual_try = 0;
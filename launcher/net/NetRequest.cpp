@@ -113,7 +113,11 @@ void NetRequest::executeTask()
 #endif
 
     m_last_progress_time = m_clock.now();
+    m_request_start = m_last_progress_time;
     m_last_progress_bytes = 0;
+    m_bytes_received = 0;
+    m_time_to_first_byte = 0;
+    m_headers_received = false;
 
     auto rep = getReply(request);
     if (rep == nullptr)  // it failed
@@ -158,6 +162,8 @@ void NetRequest::onProgress(qint64 bytesReceived, qint64 bytesTotal)
 
     setDetails(dl_progress + "\n" + dl_speed_str);
 
+    m_bytes_received = bytesReceived;
+
     setProgress(bytesReceived, bytesTotal);
 }
 
@@ -276,11 +282,16 @@ void NetRequest::downloadFinished()
         return;
     }
 
+    if (!notifyHeadersReceived()) {
+        emit failed("failed to initialize the sink for the response");
+        emit finished();
+        return;
+    }
+
     // make sure we got all the remaining data, if any
-    auto data = m_reply->readAll();
-    if (data.size()) {
-        qCDebug(logCat) << getUid().toString() << "Writing extra" << data.size() << "bytes";
-        m_state = m_sink->write(data);
+    if (auto available = m_reply->bytesAvailable(); available > 0) {
+        qCDebug(logCat) << getUid().toString() << "Writing extra" << available << "bytes";
+        m_state = m_sink->writeFrom(*m_reply);
         if (m_state != State::Succeeded) {
             qCDebug(logCat) << getUid().toString() << "Request failed to write:" << m_url.toString();
             m_sink->abort();
@@ -308,17 +319,33 @@ void NetRequest::downloadFinished()
 void NetRequest::downloadReadyRead()
 {
     if (m_state == State::Running) {
-        auto data = m_reply->readAll();
-        m_state = m_sink->write(data);
+        if (!notifyHeadersReceived())
+            return;
+        m_state = m_sink->writeFrom(*m_reply);
         if (m_state == State::Failed) {
             qCCritical(logCat) << getUid().toString() << "Failed to process response chunk";
         }
-        // qDebug() << "Request" << m_url.toString() << "gained" << data.size() << "bytes";
     } else {
         qCCritical(logCat) << getUid().toString() << "Cannot write download data! illegal status " << m_status;
     }
 }
 
+auto NetRequest::notifyHeadersReceived() -> bool
+{
+    if (m_headers_received)
+        return m_state != State::Failed;
+    m_headers_received = true;
+    m_time_to_first_byte = std::chrono::duration_cast<std::chrono::milliseconds>(m_clock.now() - m_request_start).count();
+
+    m_state = m_sink->headersReceived(*m_reply);
+    if (m_state == State::Failed) {
+        qCCritical(logCat) << getUid().toString() << "Sink rejected the response for" << m_url.toString();
+        m_sink->abort();
+        return false;
+    }
+    return true;
+}
+
 auto NetRequest::abort() -> bool
 {
     m_state = State::AbortedByUser;
@@ -343,6 +370,15 @@ QNetworkReply::NetworkError NetRequest::error() const
     return m_reply ? m_reply->error() : QNetworkReply::NoError;
 }
 
+bool NetRequest::usedHttp2() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    return m_reply && m_reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+#else
+    return m_reply && m_reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool();
+#endif
+}
+
 QUrl NetRequest::url() const
 {
     return m_url;
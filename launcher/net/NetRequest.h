@@ -78,8 +78,17 @@ class NetRequest : public Task {
     QNetworkReply::NetworkError error() const;
     QString errorString() const;
 
+    /// bytes received in the last attempt
+    qint64 bytesReceived() const { return m_bytes_received; }
+    /// time between sending the request and getting the reply headers in the last attempt, in milliseconds
+    qint64 timeToFirstByte() const { return m_time_to_first_byte; }
+    /// whether the last reply was multiplexed over HTTP/2
+    bool usedHttp2() const;
+
    private:
     auto handleRedirect() -> bool;
+    /// lets the sink inspect the reply headers once, before any data is written
+    auto notifyHeadersReceived() -> bool;
     virtual QNetworkReply* getReply(QNetworkRequest&) = 0;
 
    protected slots:
@@ -99,12 +108,16 @@ class NetRequest : public Task {
 
     std::chrono::steady_clock m_clock;
     std::chrono::time_point<std::chrono::steady_clock> m_last_progress_time;
+    std::chrono::time_point<std::chrono::steady_clock> m_request_start;
     qint64 m_last_progress_bytes;
+    qint64 m_bytes_received = 0;
+    qint64 m_time_to_first_byte = 0;
 
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
     /// the network reply
     unique_qobject_ptr<QNetworkReply> m_reply;
+    bool m_headers_received = false;
 
     /// source URL
     QUrl m_url;
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "NetworkScheduler.h"
+
+#include <QtMath>
+
+#include "net/Logging.h"
+
+namespace Net {
+
+// never go below this many requests per host
+static constexpr int s_minLimit = 2;
+// how many multiplexed streams per base slot we allow on HTTP/2 hosts
+static constexpr int s_http2Factor = 4;
+// length of the throughput measurement window
+static constexpr qint64 s_windowMs = 2000;
+// weight of new samples in the latency average
+static constexpr double s_latencyWeight = 0.2;
+
+NetworkScheduler* NetworkScheduler::instance()
+{
+    static NetworkScheduler s_instance;
+    return &s_instance;
+}
+
+NetworkScheduler::NetworkScheduler(QObject* parent) : QObject(parent)
+{
+    m_clock.start();
+}
+
+void NetworkScheduler::setBaseLimit(int limit)
+{
+    limit = qMax(1, limit);
+    if (limit == m_baseLimit)
+        return;
+    m_baseLimit = limit;
+    // start over with the new setting
+    for (auto& host : m_hosts) {
+        host.limit = qMin(qMax(host.limit, m_baseLimit), maxLimit(host));
+        host.limitAtLastWindow = host.limit;
+    }
+    emit capacityAvailable();
+}
+
+NetworkScheduler::HostState& NetworkScheduler::state(const QString& host)
+{
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end()) {
+        HostState state;
+        state.limit = m_baseLimit;
+        state.limitAtLastWindow = m_baseLimit;
+        state.windowStart = m_clock.elapsed();
+        it = m_hosts.insert(host, state);
+    }
+    return *it;
+}
+
+int NetworkScheduler::maxLimit(const HostState& state) const
+{
+    // HTTP/1.1 requests beyond the base limit would only queue for a connection
+    return state.http2 ? m_baseLimit * s_http2Factor : m_baseLimit;
+}
+
+int NetworkScheduler::fairShare(const HostState& state, const void* job) const
+{
+    QSet<const void*> jobs = state.waiting;
+    for (auto it = state.jobInFlight.cbegin(); it != state.jobInFlight.cend(); ++it) {
+        if (it.value() > 0)
+            jobs.insert(it.key());
+    }
+    jobs.insert(job);
+    return qMax(1, qCeil(double(state.limit) / jobs.size()));
+}
+
+int NetworkScheduler::limit(const QString& host) const
+{
+    auto it = m_hosts.constFind(host);
+    return it == m_hosts.cend() ? m_baseLimit : it->limit;
+}
+
+bool NetworkScheduler::tryAcquire(const QString& host, const void* job)
+{
+    auto& hostState = state(host);
+    const int jobInFlight = hostState.jobInFlight.value(job);
+
+    bool othersWaiting = !hostState.waiting.isEmpty() && !(hostState.waiting.size() == 1 && hostState.waiting.contains(job));
+    if (hostState.inFlight >= hostState.limit || (othersWaiting && jobInFlight >= fairShare(hostState, job))) {
+        hostState.waiting.insert(job);
+        return false;
+    }
+
+    hostState.waiting.remove(job);
+    hostState.inFlight++;
+    hostState.jobInFlight[job] = jobInFlight + 1;
+    return true;
+}
+
+void NetworkScheduler::release(const QString& host, const void* job, const Sample& sample)
+{
+    auto& hostState = state(host);
+    const bool saturated = hostState.inFlight >= hostState.limit;
+
+    hostState.inFlight = qMax(0, hostState.inFlight - 1);
+    auto jobInFlight = hostState.jobInFlight.value(job) - 1;
+    if (jobInFlight > 0)
+        hostState.jobInFlight[job] = jobInFlight;
+    else
+        hostState.jobInFlight.remove(job);
+
+    m_bytesReceived += sample.bytes;
+    adapt(hostState, sample, saturated);
+
+    emit capacityAvailable();
+}
+
+void NetworkScheduler::forgetJob(const void* job)
+{
+    for (auto& host : m_hosts) {
+        host.waiting.remove(job);
+    }
+}
+
+void NetworkScheduler::adapt(HostState& state, const Sample& sample, bool saturated)
+{
+    const int oldLimit = state.limit;
+
+    if (!sample.succeeded) {
+        // back off quickly, the host may be rate limiting us
+        state.limit = qMax(qMin(s_minLimit, m_baseLimit), state.limit / 2);
+    } else {
+        state.http2 |= sample.http2;
+
+        if (sample.timeToFirstByteMs > 0) {
+            const double latency = sample.timeToFirstByteMs;
+            state.latencyMs = state.latencyMs == 0 ? latency : state.latencyMs + s_latencyWeight * (latency - state.latencyMs);
+            if (state.bestLatencyMs == 0 || latency < state.bestLatencyMs)
+                state.bestLatencyMs = latency;
+        }
+
+        if (state.bestLatencyMs > 0 && state.latencyMs > state.bestLatencyMs * 4) {
+            // requests are piling up at the server, use fewer of them
+            state.limit = qMax(qMin(s_minLimit, m_baseLimit), state.limit - 1);
+        } else if (saturated && (state.bestLatencyMs == 0 || state.latencyMs <= state.bestLatencyMs * 2)) {
+            // all slots are busy and the host keeps up, try one more
+            state.limit = qMin(maxLimit(state), state.limit + 1);
+        }
+
+        state.windowBytes += sample.bytes;
+    }
+
+    const qint64 now = m_clock.elapsed();
+    const qint64 windowLength = now - state.windowStart;
+    if (windowLength >= s_windowMs) {
+        const double rate = double(state.windowBytes) * 1000 / windowLength;
+        // the last increase made things slower, undo it
+        if (state.limitAtLastWindow < state.limit && rate < state.lastRate * 0.9)
+            state.limit = state.limitAtLastWindow;
+
+        state.lastRate = rate;
+        state.limitAtLastWindow = state.limit;
+        state.windowStart = now;
+        state.windowBytes = 0;
+    }
+
+    if (state.limit != oldLimit)
+        qCDebug(taskNetLogC) << "Concurrency limit for host changed from" << oldLimit << "to" << state.limit;
+}
+
+}  // namespace Net
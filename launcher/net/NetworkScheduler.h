@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+namespace Net {
+
+/**
+ * Process-wide scheduler for network requests, shared by every NetJob.
+ *
+ * Each host gets its own concurrency limit. It starts at the base limit (the NumberOfConcurrentDownloads
+ * setting), is allowed to grow for hosts that multiplex requests over HTTP/2, and adapts to the observed
+ * latency, throughput and failures of the requests made to that host.
+ * When several jobs compete for the same host, each one gets a fair share of its slots.
+ */
+class NetworkScheduler : public QObject {
+    Q_OBJECT
+   public:
+    struct Sample {
+        bool succeeded = false;
+        bool http2 = false;
+        qint64 bytes = 0;
+        qint64 timeToFirstByteMs = 0;
+    };
+
+    static NetworkScheduler* instance();
+
+    void setBaseLimit(int limit);
+
+    /// reserves a slot for one request of the given job, returns false if the host is busy
+    bool tryAcquire(const QString& host, const void* job);
+    /// frees a slot taken with tryAcquire, and learns from how the request went
+    void release(const QString& host, const void* job, const Sample& sample);
+    /// removes every pending wait of the given job
+    void forgetJob(const void* job);
+
+    int limit(const QString& host) const;
+    /// total amount of data received by finished requests, used to attribute traffic to launch phases
+    qint64 bytesReceived() const { return m_bytesReceived; }
+
+   signals:
+    /// some slot got freed, jobs waiting on it should try to schedule again
+    void capacityAvailable();
+
+   private:
+    struct HostState {
+        int limit = 0;
+        int inFlight = 0;
+        bool http2 = false;
+        QHash<const void*, int> jobInFlight;
+        QSet<const void*> waiting;
+
+        double latencyMs = 0;
+        double bestLatencyMs = 0;
+
+        // aggregated throughput, measured over fixed windows
+        qint64 windowStart = 0;
+        qint64 windowBytes = 0;
+        double lastRate = 0;
+        int limitAtLastWindow = 0;
+    };
+
+    explicit NetworkScheduler(QObject* parent = nullptr);
+
+    HostState& state(const QString& host);
+    int maxLimit(const HostState& state) const;
+    int fairShare(const HostState& state, const void* job) const;
+    void adapt(HostState& state, const Sample& sample, bool saturated);
+
+    QHash<QString, HostState> m_hosts;
+    int m_baseLimit = 6;
+    qint64 m_bytesReceived = 0;
+    QElapsedTimer m_clock;
+};
+
+}  // namespace Net
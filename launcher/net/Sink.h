@@ -46,7 +46,11 @@ class Sink {
 
    public:
     virtual auto init(QNetworkRequest& request) -> Task::State = 0;
-    virtual auto write(QByteArray& data) -> Task::State = 0;
+    /// called once per response, before the first write, when the reply headers are known
+    virtual auto headersReceived(QNetworkReply&) -> Task::State { return Task::State::Running; }
+    virtual auto write(const QByteArray& data) -> Task::State = 0;
+    /// takes what the reply has available, sinks that keep the data can read it straight into their own buffers
+    virtual auto writeFrom(QIODevice& device) -> Task::State { return write(device.readAll()); }
     virtual auto abort() -> Task::State = 0;
     virtual auto finalize(QNetworkReply& reply) -> Task::State = 0;
 
@@ -84,7 +88,7 @@ class Sink {
         }
         return success;
     }
-    bool writeAllValidators(QByteArray& data)
+    bool writeAllValidators(const QByteArray& data)
     {
         for (auto& validator : validators) {
             if (!validator->write(data))
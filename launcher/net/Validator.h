@@ -44,7 +44,8 @@ class Validator {
 
    public: /* methods */
     virtual bool init(QNetworkRequest& request) = 0;
-    virtual bool write(QByteArray& data) = 0;
+    /// data may only be a view into the buffer of the sink, don't keep a reference to it past the call
+    virtual bool write(const QByteArray& data) = 0;
     virtual bool abort() = 0;
     virtual bool validate(QNetworkReply& reply) = 0;
 };
@@ -77,7 +77,7 @@ auto ImgurAlbumCreation::Sink::init(QNetworkRequest& request) -> Task::State
     return Task::State::Running;
 }
 
-auto ImgurAlbumCreation::Sink::write(QByteArray& data) -> Task::State
+auto ImgurAlbumCreation::Sink::write(const QByteArray& data) -> Task::State
 {
     m_output.append(data);
     return Task::State::Running;
@@ -81,7 +81,7 @@ auto ImgurUpload::Sink::init(QNetworkRequest& request) -> Task::State
     return Task::State::Running;
 }
 
-auto ImgurUpload::Sink::write(QByteArray& data) -> Task::State
+auto ImgurUpload::Sink::write(const QByteArray& data) -> Task::State
 {
     m_output.append(data);
     return Task::State::Running;
@@ -48,7 +48,7 @@ class ImgurUpload : public Net::NetRequest {
 
        public:
         auto init(QNetworkRequest& request) -> Task::State override;
-        auto write(QByteArray& data) -> Task::State override;
+        auto write(const QByteArray& data) -> Task::State override;
         auto abort() -> Task::State override;
         auto finalize(QNetworkReply& reply) -> Task::State override;
         auto hasLocalData() -> bool override { return false; }
@@ -37,37 +37,663 @@
 #include "settings/INIFile.h"
 #include <FileSystem.h>
 
+#include <QDataStream>
+#include <QDateTime>
 #include <QDebug>
 #include <QFile>
-#include <QSaveFile>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
 #include <QStringList>
-#include <QTemporaryFile>
-#include <QTextStream>
 
-#include <QSettings>
+#include <utility>
 
-INIFile::INIFile() {}
+// The file format is the one QSettings uses for QSettings::IniFormat, so files stay readable by older versions.
+// Reading and writing it ourselves avoids constructing a QSettings (and re-parsing the file) for every load and save.
 
-bool INIFile::saveFile(QString fileName)
+#if defined(Q_OS_WIN)
+static const char s_eol[] = "\r\n";
+#else
+static const char s_eol[] = "\n";
+#endif
+
+static const char s_hexDigits[] = "0123456789ABCDEF";
+
+// Qt 6 stores text as UTF-8, Qt 5 (without a codec set) as Latin-1 with everything else escaped
+static QString decodeIniBytes(const char* data, qsizetype size)
 {
-    if (!contains("ConfigVersion"))
-        insert("ConfigVersion", "1.2");
-    QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
-    _settings_obj.setFallbacksEnabled(false);
-    _settings_obj.clear();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return QString::fromUtf8(data, size);
+#else
+    return QString::fromLatin1(data, size);
+#endif
+}
+
+// only what QSettings considers white space, multi-byte UTF-8 sequences must not be touched
+static bool isIniSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v';
+}
+
+static int fromHex(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+static int fromOct(char ch)
+{
+    return (ch >= '0' && ch <= '7') ? ch - '0' : -1;
+}
 
-    for (Iterator iter = begin(); iter != end(); iter++)
-        _settings_obj.setValue(iter.key(), iter.value());
+static void escapeKey(const QString& key, QByteArray& result)
+{
+    result.reserve(result.size() + key.size() * 3 / 2);
+    for (auto c : key) {
+        auto ch = c.unicode();
+        if (ch == '/') {
+            result += '\\';
+        } else if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-' ||
+                   ch == '.') {
+            result += char(ch);
+        } else if (ch <= 0xFF) {
+            result += '%';
+            result += s_hexDigits[ch / 16];
+            result += s_hexDigits[ch % 16];
+        } else {
+            result += "%U";
+            for (int shift = 12; shift >= 0; shift -= 4)
+                result += s_hexDigits[(ch >> shift) & 0xF];
+        }
+    }
+}
+
+static QString unescapeKey(const QByteArray& data, qsizetype from, qsizetype to)
+{
+    const QString key = decodeIniBytes(data.constData() + from, to - from);
+    QString result;
+    result.reserve(key.size());
+
+    qsizetype i = 0;
+    while (i < key.size()) {
+        auto ch = key.at(i);
+        if (ch == '\\') {
+            result += '/';
+            ++i;
+            continue;
+        }
+        if (ch != '%' || i == key.size() - 1) {
+            result += ch;
+            ++i;
+            continue;
+        }
 
-    _settings_obj.sync();
+        qsizetype firstDigit = i + 1;
+        int numDigits = 2;
+        if (key.at(firstDigit) == 'U') {
+            ++firstDigit;
+            numDigits = 4;
+        }
+
+        bool ok = false;
+        ushort code = 0;
+        if (firstDigit + numDigits <= key.size())
+            code = key.mid(firstDigit, numDigits).toUShort(&ok, 16);
+        if (!ok) {
+            result += '%';
+            ++i;
+            continue;
+        }
+        result += QChar(code);
+        i = firstDigit + numDigits;
+    }
+    return result;
+}
 
-    if (auto status = _settings_obj.status(); status != QSettings::Status::NoError) {
-        // Shouldn't be possible!
-        Q_ASSERT(status != QSettings::Status::FormatError);
+static void escapeString(const QString& str, QByteArray& result)
+{
+    bool needsQuotes = false;
+    bool escapeNextIfDigit = false;
+    // serialized binary data is written byte by byte
+    const bool encodeText = !(str.startsWith("@ByteArray(") || str.startsWith("@Variant(") || str.startsWith("@DateTime("));
+    const qsizetype start = result.size();
 
-        if (status == QSettings::Status::AccessError)
-            qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
+    result.reserve(start + str.size() * 3 / 2);
+    for (qsizetype i = 0; i < str.size(); ++i) {
+        auto ch = str.at(i).unicode();
+        if (ch == ';' || ch == ',' || ch == '=')
+            needsQuotes = true;
 
+        if (escapeNextIfDigit && ch < 0x80 && fromHex(char(ch)) != -1) {
+            result += "\\x" + QByteArray::number(ch, 16);
+            continue;
+        }
+        escapeNextIfDigit = false;
+
+        switch (ch) {
+            case '\0':
+                result += "\\0";
+                escapeNextIfDigit = true;
+                break;
+            case '\a':
+                result += "\\a";
+                break;
+            case '\b':
+                result += "\\b";
+                break;
+            case '\f':
+                result += "\\f";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            case '\v':
+                result += "\\v";
+                break;
+            case '"':
+            case '\\':
+                result += '\\';
+                result += char(ch);
+                break;
+            default:
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+                if (ch <= 0x1F || (ch >= 0x7F && !encodeText)) {
+                    result += "\\x" + QByteArray::number(ch, 16);
+                    escapeNextIfDigit = true;
+                } else if (ch >= 0x80) {
+                    // keep surrogate pairs together
+                    qsizetype length = (str.at(i).isHighSurrogate() && i + 1 < str.size()) ? 2 : 1;
+                    result += str.mid(i, length).toUtf8();
+                    i += length - 1;
+                } else {
+                    result += char(ch);
+                }
+#else
+                Q_UNUSED(encodeText)
+                if (ch <= 0x1F || ch >= 0x7F) {
+                    result += "\\x" + QByteArray::number(ch, 16);
+                    escapeNextIfDigit = true;
+                } else {
+                    result += char(ch);
+                }
+#endif
+        }
+    }
+
+    if (needsQuotes || (start < result.size() && (result.at(start) == ' ' || result.at(result.size() - 1) == ' '))) {
+        result.insert(start, '"');
+        result += '"';
+    }
+}
+
+static void escapeStringList(const QStringList& strings, QByteArray& result)
+{
+    if (strings.isEmpty()) {
+        // an empty list reads back as an invalid QVariant, which converts to an empty list again
+        result += "@Invalid()";
+        return;
+    }
+    for (qsizetype i = 0; i < strings.size(); ++i) {
+        if (i != 0)
+            result += ", ";
+        escapeString(strings.at(i), result);
+    }
+}
+
+static void chopTrailingSpaces(QString& str, qsizetype limit)
+{
+    auto n = str.size() - 1;
+    QChar ch;
+    while (n >= limit && ((ch = str.at(n)) == ' ' || ch == '\t'))
+        str.truncate(n--);
+}
+
+// returns true if the value is a list, in which case it's put in stringListResult
+static bool unescapeStringList(const QByteArray& str, QString& stringResult, QStringList& stringListResult)
+{
+    static const char escapeCodes[][2] = { { 'a', '\a' }, { 'b', '\b' }, { 'f', '\f' }, { 'n', '\n' },  { 'r', '\r' },  { 't', '\t' },
+                                           { 'v', '\v' }, { '"', '"' },  { '?', '?' },  { '\'', '\'' }, { '\\', '\\' } };
+
+    bool isStringList = false;
+    bool inQuotedString = false;
+    bool currentValueIsQuoted = false;
+    uint escapeVal = 0;
+    qsizetype i = 0;
+    qsizetype chopLimit = 0;
+
+    enum class State { SkipSpaces, Normal, HexEscape, OctEscape, End } state = State::SkipSpaces;
+    while (state != State::End) {
+        switch (state) {
+            case State::SkipSpaces:
+                while (i < str.size() && (str.at(i) == ' ' || str.at(i) == '\t'))
+                    ++i;
+                state = State::Normal;
+                chopLimit = stringResult.size();
+                break;
+            case State::Normal: {
+                if (i >= str.size()) {
+                    if (!currentValueIsQuoted)
+                        chopTrailingSpaces(stringResult, chopLimit);
+                    state = State::End;
+                    break;
+                }
+                char ch = str.at(i);
+                if (ch == '\\') {
+                    ++i;
+                    if (i >= str.size()) {
+                        state = State::End;
+                        break;
+                    }
+                    ch = str.at(i++);
+                    bool simpleEscape = false;
+                    for (auto const& escapeCode : escapeCodes) {
+                        if (ch == escapeCode[0]) {
+                            stringResult += QLatin1Char(escapeCode[1]);
+                            simpleEscape = true;
+                            break;
+                        }
+                    }
+                    if (simpleEscape) {
+                        chopLimit = stringResult.size();
+                        break;
+                    }
+                    if (ch == 'x') {
+                        escapeVal = 0;
+                        if (i >= str.size()) {
+                            state = State::End;
+                            break;
+                        }
+                        if (fromHex(str.at(i)) != -1)
+                            state = State::HexEscape;
+                    } else if (int o = fromOct(ch); o != -1) {
+                        escapeVal = o;
+                        state = State::OctEscape;
+                    } else if (ch == '\n' || ch == '\r') {
+                        // escaped line break, the value continues on the next line
+                        if (i < str.size()) {
+                            char ch2 = str.at(i);
+                            if ((ch2 == '\n' || ch2 == '\r') && ch2 != ch)
+                                ++i;
+                        }
+                    }
+                    // any other escaped character is skipped
+                    chopLimit = stringResult.size();
+                } else if (ch == '"') {
+                    ++i;
+                    currentValueIsQuoted = true;
+                    inQuotedString = !inQuotedString;
+                    if (!inQuotedString)
+                        state = State::SkipSpaces;
+                } else if (ch == ',' && !inQuotedString) {
+                    if (!currentValueIsQuoted)
+                        chopTrailingSpaces(stringResult, chopLimit);
+                    if (!isStringList) {
+                        isStringList = true;
+                        stringListResult.clear();
+                    }
+                    stringListResult.append(stringResult);
+                    stringResult.clear();
+                    currentValueIsQuoted = false;
+                    ++i;
+                    state = State::SkipSpaces;
+                } else {
+                    qsizetype j = i + 1;
+                    while (j < str.size()) {
+                        ch = str.at(j);
+                        if (ch == '\\' || ch == '"' || ch == ',')
+                            break;
+                        ++j;
+                    }
+                    stringResult += decodeIniBytes(str.constData() + i, j - i);
+                    i = j;
+                }
+                break;
+            }
+            case State::HexEscape:
+            case State::OctEscape: {
+                int digit = -1;
+                if (i < str.size())
+                    digit = state == State::HexEscape ? fromHex(str.at(i)) : fromOct(str.at(i));
+                if (digit != -1) {
+                    escapeVal = (escapeVal << (state == State::HexEscape ? 4 : 3)) + digit;
+                    ++i;
+                    break;
+                }
+                if (QChar::requiresSurrogates(escapeVal)) {
+                    stringResult += QChar(QChar::highSurrogate(escapeVal));
+                    stringResult += QChar(QChar::lowSurrogate(escapeVal));
+                } else {
+                    stringResult += QChar(ushort(escapeVal));
+                }
+                chopLimit = stringResult.size();
+                state = i < str.size() ? State::Normal : State::End;
+                break;
+            }
+            case State::End:
+                break;
+        }
+    }
+
+    if (isStringList)
+        stringListResult.append(stringResult);
+    return isStringList;
+}
+
+static QStringList splitArgs(const QString& s, qsizetype idx)
+{
+    // "@Rect(1 2 3 4)" -> { "1", "2", "3", "4" }
+    return s.mid(idx + 1, s.size() - idx - 2).split(' ', Qt::SkipEmptyParts);
+}
+
+static QString variantToString(const QVariant& v)
+{
+    QString result;
+
+    switch (v.userType()) {
+        case QMetaType::UnknownType:
+            result = "@Invalid()";
+            break;
+        case QMetaType::QByteArray: {
+            // the data may contain null bytes, so pass the size explicitly
+            auto a = v.toByteArray();
+            result = "@ByteArray(" + QString::fromLatin1(a.constData(), a.size()) + ")";
+            break;
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        case QMetaType::Float:
+#endif
+        case QMetaType::QString:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Bool:
+        case QMetaType::Double:
+            result = v.toString();
+            if (result.contains(QChar::Null))
+                result = "@String(" + result + ")";
+            else if (result.startsWith('@'))
+                result.prepend('@');
+            break;
+        case QMetaType::QRect: {
+            auto r = v.toRect();
+            result = QString::asprintf("@Rect(%d %d %d %d)", r.x(), r.y(), r.width(), r.height());
+            break;
+        }
+        case QMetaType::QSize: {
+            auto s = v.toSize();
+            result = QString::asprintf("@Size(%d %d)", s.width(), s.height());
+            break;
+        }
+        case QMetaType::QPoint: {
+            auto p = v.toPoint();
+            result = QString::asprintf("@Point(%d %d)", p.x(), p.y());
+            break;
+        }
+        default: {
+            auto version = QDataStream::Qt_4_0;
+            const char* typeSpec = "@Variant(";
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            if (v.userType() == QMetaType::QDateTime) {
+                version = QDataStream::Qt_5_6;
+                typeSpec = "@DateTime(";
+            }
+#endif
+            QByteArray a;
+            {
+                QDataStream s(&a, QIODevice::WriteOnly);
+                s.setVersion(version);
+                s << v;
+            }
+            result = QLatin1String(typeSpec) + QString::fromLatin1(a.constData(), a.size()) + ")";
+            break;
+        }
+    }
+
+    return result;
+}
+
+static QVariant stringToVariant(const QString& s)
+{
+    if (s.startsWith('@')) {
+        if (s.endsWith(')')) {
+            if (s.startsWith("@ByteArray(")) {
+                return QVariant(s.mid(11, s.size() - 12).toLatin1());
+            } else if (s.startsWith("@String(")) {
+                return QVariant(s.mid(8, s.size() - 9));
+            } else if (s.startsWith("@Variant(") || s.startsWith("@DateTime(")) {
+                auto version = s.at(1) == 'D' ? QDataStream::Qt_5_6 : QDataStream::Qt_4_0;
+                auto offset = s.at(1) == 'D' ? 10 : 9;
+                QByteArray a = s.mid(offset, s.size() - offset - 1).toLatin1();
+                QDataStream stream(&a, QIODevice::ReadOnly);
+                stream.setVersion(version);
+                QVariant result;
+                stream >> result;
+                return result;
+            } else if (s.startsWith("@Rect(")) {
+                auto args = splitArgs(s, 5);
+                if (args.size() == 4)
+                    return QVariant(QRect(args[0].toInt(), args[1].toInt(), args[2].toInt(), args[3].toInt()));
+            } else if (s.startsWith("@Size(")) {
+                auto args = splitArgs(s, 5);
+                if (args.size() == 2)
+                    return QVariant(QSize(args[0].toInt(), args[1].toInt()));
+            } else if (s.startsWith("@Point(")) {
+                auto args = splitArgs(s, 6);
+                if (args.size() == 2)
+                    return QVariant(QPoint(args[0].toInt(), args[1].toInt()));
+            } else if (s == "@Invalid()") {
+                return QVariant();
+            }
+        }
+        if (s.startsWith("@@"))
+            return QVariant(s.mid(1));
+    }
+
+    return QVariant(s);
+}
+
+static QVariant stringListToVariant(const QStringList& list)
+{
+    QStringList outStringList = list;
+    for (qsizetype i = 0; i < outStringList.size(); ++i) {
+        const QString& str = outStringList.at(i);
+        if (!str.startsWith('@'))
+            continue;
+        if (str.size() >= 2 && str.at(1) == '@') {
+            outStringList[i].remove(0, 1);
+        } else {
+            // it's a list of serialized variants
+            QVariantList variantList;
+            variantList.reserve(list.size());
+            for (auto const& item : list)
+                variantList.append(stringToVariant(item));
+            return variantList;
+        }
+    }
+    return outStringList;
+}
+
+// Finds the next logical line, skipping comments and taking quoted and escaped line breaks into account.
+static bool readLine(const QByteArray& data, qsizetype& dataPos, qsizetype& lineStart, qsizetype& lineLen, qsizetype& equalsPos)
+{
+    const qsizetype dataLen = data.size();
+    bool inQuotes = false;
+
+    equalsPos = -1;
+
+    lineStart = dataPos;
+    while (lineStart < dataLen && isIniSpace(data.at(lineStart)))
+        ++lineStart;
+
+    qsizetype i = lineStart;
+    while (i < dataLen) {
+        char ch = data.at(i);
+        ++i;
+        if (ch == '=') {
+            if (!inQuotes && equalsPos == -1)
+                equalsPos = i - 1;
+        } else if (ch == '\n' || ch == '\r') {
+            if (i == lineStart + 1) {
+                ++lineStart;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        } else if (ch == '\\') {
+            if (i < dataLen) {
+                char escaped = data.at(i++);
+                if (i < dataLen) {
+                    char next = data.at(i);
+                    if ((escaped == '\n' && next == '\r') || (escaped == '\r' && next == '\n'))
+                        ++i;
+                }
+            }
+        } else if (ch == '"') {
+            inQuotes = !inQuotes;
+        } else if (ch == ';') {
+            if (i == lineStart + 1) {
+                // comment line
+                while (i < dataLen && data.at(i) != '\n' && data.at(i) != '\r')
+                    ++i;
+                while (i < dataLen && isIniSpace(data.at(i)))
+                    ++i;
+                lineStart = i;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        }
+    }
+
+    dataPos = i;
+    lineLen = i - lineStart;
+    return lineLen > 0;
+}
+
+// Parses the whole file into the map, returns false if a line could not be understood
+static bool parseIniData(const QByteArray& data, QMap<QString, QVariant>& map)
+{
+    bool ok = true;
+    qsizetype dataPos = 0;
+    qsizetype lineStart;
+    qsizetype lineLen;
+    qsizetype equalsPos;
+    QString currentSection;
+
+    // skip the UTF-8 BOM, if any
+    if (data.startsWith("\xef\xbb\xbf"))
+        dataPos = 3;
+
+    while (readLine(data, dataPos, lineStart, lineLen, equalsPos)) {
+        if (data.at(lineStart) == '[') {
+            auto sectionEnd = data.indexOf(']', lineStart);
+            if (sectionEnd == -1 || sectionEnd >= lineStart + lineLen) {
+                ok = false;
+                sectionEnd = lineStart + lineLen;
+            }
+            QByteArray section = data.mid(lineStart + 1, sectionEnd - lineStart - 1).trimmed();
+            if (section.toLower() == "general") {
+                currentSection.clear();
+            } else {
+                if (section.toLower() == "%general")
+                    currentSection = QString::fromLatin1(section.mid(1));
+                else
+                    currentSection = unescapeKey(section, 0, section.size());
+                currentSection += '/';
+            }
+            continue;
+        }
+
+        if (equalsPos == -1) {
+            ok = false;
+            continue;
+        }
+
+        qsizetype keyEnd = equalsPos;
+        while (keyEnd > lineStart && (data.at(keyEnd - 1) == ' ' || data.at(keyEnd - 1) == '\t'))
+            --keyEnd;
+        QString key = currentSection + unescapeKey(data, lineStart, keyEnd);
+
+        QString stringValue;
+        QStringList stringListValue;
+        auto value = data.mid(equalsPos + 1, lineStart + lineLen - equalsPos - 1);
+        if (unescapeStringList(value, stringValue, stringListValue))
+            map.insert(key, stringListToVariant(stringListValue));
+        else
+            map.insert(key, stringToVariant(stringValue));
+    }
+
+    return ok;
+}
+
+static QByteArray serializeIniData(const QMap<QString, QVariant>& map)
+{
+    // keys with a slash go into sections, like QSettings groups
+    QMap<QString, QList<std::pair<QString, QVariant>>> sections;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        auto slash = it.key().indexOf('/');
+        if (slash == -1)
+            sections[QString()].append({ it.key(), it.value() });
+        else
+            sections[it.key().left(slash)].append({ it.key().mid(slash + 1), it.value() });
+    }
+
+    QByteArray data;
+    bool first = true;
+    for (auto it = sections.constBegin(); it != sections.constEnd(); ++it) {
+        QByteArray sectionName;
+        escapeKey(it.key(), sectionName);
+        if (sectionName.isEmpty())
+            sectionName = "General";
+        else if (sectionName.toLower() == "general")
+            sectionName = "%General";
+
+        if (!first)
+            data += s_eol;
+        first = false;
+        data += '[' + sectionName + ']' + s_eol;
+
+        for (auto const& [key, value] : it.value()) {
+            escapeKey(key, data);
+            data += '=';
+            if (value.userType() == QMetaType::QStringList ||
+                (value.userType() == QMetaType::QVariantList && value.toList().size() != 1)) {
+                QStringList strings;
+                for (auto const& item : value.toList())
+                    strings.append(variantToString(item));
+                escapeStringList(strings, data);
+            } else {
+                escapeString(variantToString(value), data);
+            }
+            data += s_eol;
+        }
+    }
+    return data;
+}
+
+INIFile::INIFile() {}
+
+bool INIFile::saveFile(QString fileName)
+{
+    if (!contains("ConfigVersion"))
+        insert("ConfigVersion", "1.2");
+
+    try {
+        FS::write(fileName, serializeIniData(*this));
+    } catch (const FS::FileSystemException& e) {
+        qCritical() << "Failed to save" << fileName << ":" << e.cause();
         return false;
     }
 
@@ -114,14 +740,9 @@ QString unquote(QString str)
     return str;
 }
 
-bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
+bool parseOldFileFormat(const QByteArray& data, QMap<QString, QVariant>& map)
 {
-    QTextStream in(device.readAll());
-#if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
-    in.setCodec("UTF-8");
-#endif
-
-    QStringList lines = in.readAll().split('\n');
+    QStringList lines = QString::fromUtf8(data).split('\n');
     for (int i = 0; i < lines.count(); i++) {
         QString& lineRaw = lines[i];
         // Ignore comments.
@@ -152,55 +773,42 @@ bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
 
 bool INIFile::loadFile(QString fileName)
 {
-    QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
-    _settings_obj.setFallbacksEnabled(false);
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    return loadFile(file.readAll());
+}
 
-    if (auto status = _settings_obj.status(); status != QSettings::Status::NoError) {
-        if (status == QSettings::Status::AccessError)
-            qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
-        if (status == QSettings::Status::FormatError)
-            qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
+bool INIFile::loadFile(QByteArray data)
+{
+    QMap<QString, QVariant> parsed;
+    if (!parseIniData(data, parsed)) {
+        qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
         return false;
     }
-    if (!_settings_obj.value("ConfigVersion").isValid()) {
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly))
-            return false;
-        QSettings::SettingsMap map;
-        parseOldFileFormat(file, map);
-        file.close();
-        for (auto&& key : map.keys())
-            insert(key, map.value(key));
+
+    if (!parsed.value("ConfigVersion").isValid()) {
+        QMap<QString, QVariant> map;
+        parseOldFileFormat(data, map);
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+            insert(it.key(), it.value());
         insert("ConfigVersion", "1.2");
-    } else if (_settings_obj.value("ConfigVersion").toString() == "1.1") {
-        for (auto&& key : _settings_obj.allKeys()) {
-            if (auto valueStr = _settings_obj.value(key).toString();
+    } else if (parsed.value("ConfigVersion").toString() == "1.1") {
+        for (auto it = parsed.constBegin(); it != parsed.constEnd(); ++it) {
+            if (auto valueStr = it.value().toString();
                 (valueStr.contains(QChar(';')) || valueStr.contains(QChar('=')) || valueStr.contains(QChar(','))) &&
                 valueStr.endsWith("\"") && valueStr.startsWith("\"")) {
-                insert(key, unquote(valueStr));
+                insert(it.key(), unquote(valueStr));
             } else
-                insert(key, _settings_obj.value(key));
+                insert(it.key(), it.value());
         }
         insert("ConfigVersion", "1.2");
     } else
-        for (auto&& key : _settings_obj.allKeys())
-            insert(key, _settings_obj.value(key));
+        for (auto it = parsed.constBegin(); it != parsed.constEnd(); ++it)
+            insert(it.key(), it.value());
     return true;
 }
 
-bool INIFile::loadFile(QByteArray data)
-{
-    QTemporaryFile file;
-    if (!file.open())
-        return false;
-    file.write(data);
-    file.flush();
-    file.close();
-    auto loaded = loadFile(file.fileName());
-    file.remove();
-    return loaded;
-}
-
 QVariant INIFile::get(QString key, QVariant def) const
 {
     if (!this->contains(key))
@@ -16,8 +16,25 @@
 #include "INISettingsObject.h"
 #include "Setting.h"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QtConcurrentRun>
+
+// changes made within this time are written together
+static constexpr int s_saveDelayMs = 500;
+
+static bool saveIniFile(INIFile ini, const QString& path)
+{
+    // don't resurrect the folder of an instance that got deleted or moved in the meantime
+    if (!QFileInfo(path).absoluteDir().exists()) {
+        qWarning() << "Not saving" << path << "as its folder doesn't exist anymore";
+        return false;
+    }
+    return ini.saveFile(path);
+}
 
 INISettingsObject::INISettingsObject(QStringList paths, QObject* parent) : SettingsObject(parent)
 {
@@ -36,12 +53,40 @@ INISettingsObject::INISettingsObject(QStringList paths, QObject* parent) : Setti
 
     m_filePath = first_path;
     m_ini.loadFile(first_path);
+
+    setupSaveTimer();
 }
 
 INISettingsObject::INISettingsObject(QString path, QObject* parent) : SettingsObject(parent)
 {
     m_filePath = path;
     m_ini.loadFile(path);
+
+    setupSaveTimer();
+}
+
+INISettingsObject::INISettingsObject(QString path, INIFile contents, QObject* parent) : SettingsObject(parent)
+{
+    m_filePath = path;
+    m_ini = std::move(contents);
+
+    setupSaveTimer();
+}
+
+INISettingsObject::~INISettingsObject()
+{
+    flush();
+}
+
+void INISettingsObject::setupSaveTimer()
+{
+    // not restarted by further changes, so nothing waits longer than the delay
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(s_saveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &INISettingsObject::saveInBackground);
+
+    if (auto app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &INISettingsObject::flush);
 }
 
 void INISettingsObject::setFilePath(const QString& filePath)
@@ -51,6 +96,7 @@ void INISettingsObject::setFilePath(const QString& filePath)
 
 bool INISettingsObject::reload()
 {
+    flush();
     return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
@@ -63,7 +109,9 @@ void INISettingsObject::resumeSave()
 {
     m_suspendSave = false;
     if (m_doSave) {
-        m_ini.saveFile(m_filePath);
+        // callers usually move the files around right after, so this can't wait
+        m_dirty = true;
+        flush();
     }
 }
 
@@ -91,7 +139,35 @@ void INISettingsObject::doSave()
     if (m_suspendSave) {
         m_doSave = true;
     } else {
-        m_ini.saveFile(m_filePath);
+        m_dirty = true;
+        if (!m_saveTimer.isActive())
+            m_saveTimer.start();
+    }
+}
+
+void INISettingsObject::saveInBackground()
+{
+    if (!m_dirty)
+        return;
+
+    // writes of the same file must not overlap, try again once the previous one is done
+    if (m_saveFuture.isRunning()) {
+        m_saveTimer.start();
+        return;
+    }
+
+    m_dirty = false;
+    m_saveFuture = QtConcurrent::run(QThreadPool::globalInstance(), saveIniFile, m_ini, m_filePath);
+}
+
+void INISettingsObject::flush()
+{
+    m_saveTimer.stop();
+    m_saveFuture.waitForFinished();
+
+    if (m_dirty) {
+        m_dirty = false;
+        saveIniFile(m_ini, m_filePath);
     }
 }
 
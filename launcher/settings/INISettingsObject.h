@@ -15,7 +15,9 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QObject>
+#include <QTimer>
 
 #include "settings/INIFile.h"
 
@@ -32,6 +34,11 @@ class INISettingsObject : public SettingsObject {
 
     explicit INISettingsObject(QString path, QObject* parent = nullptr);
 
+    /** Uses contents of the file at 'path' that were already read, e.g. on another thread. */
+    INISettingsObject(QString path, INIFile contents, QObject* parent = nullptr);
+
+    ~INISettingsObject() override;
+
     /*!
      * \brief Gets the path to the INI file.
      * \return The path to the INI file.
@@ -49,15 +56,28 @@ class INISettingsObject : public SettingsObject {
     void suspendSave() override;
     void resumeSave() override;
 
+    /*!
+     * \brief Writes pending changes to the INI file right away.
+     * Changes are normally written in the background, shortly after they are made.
+     */
+    void flush() override;
+
    protected slots:
     virtual void changeSetting(const Setting& setting, QVariant value) override;
     virtual void resetSetting(const Setting& setting) override;
 
+    void saveInBackground();
+
    protected:
     virtual QVariant retrieveValue(const Setting& setting) override;
     void doSave();
+    void setupSaveTimer();
 
    protected:
     INIFile m_ini;
     QString m_filePath;
+
+    QTimer m_saveTimer;
+    QFuture<bool> m_saveFuture;
+    bool m_dirty = false;
 };
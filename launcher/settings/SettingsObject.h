@@ -141,6 +141,8 @@ class SettingsObject : public QObject {
 
     virtual void suspendSave() = 0;
     virtual void resumeSave() = 0;
+    /// writes pending changes to disk right away, for when the files are about to be read by something else
+    virtual void flush() = 0;
    signals:
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings changes.
@@ -36,11 +36,20 @@
 #include "ConcurrentTask.h"
 
 #include <QDebug>
+#include <utility>
+
 #include "tasks/Task.h"
 
+// roughly one frame, there's no point in updating the UI faster than that
+static constexpr int s_update_interval_ms = 16;
+
 ConcurrentTask::ConcurrentTask(QObject* parent, QString task_name, int max_concurrent) : Task(parent), m_total_max_size(max_concurrent)
 {
     setObjectName(task_name);
+
+    m_update_timer.setSingleShot(true);
+    m_update_timer.setInterval(s_update_interval_ms);
+    connect(&m_update_timer, &QTimer::timeout, this, &ConcurrentTask::flushUpdates);
 }
 
 ConcurrentTask::~ConcurrentTask()
@@ -104,6 +113,9 @@ void ConcurrentTask::clear()
     m_failed.clear();
     m_queue.clear();
     m_task_progress.clear();
+    m_pending_steps.clear();
+    m_state_pending = false;
+    m_update_timer.stop();
 
     m_progress = 0;
 }
@@ -147,7 +159,7 @@ void ConcurrentTask::startSubTask(Task::Ptr next)
     auto task_progress = std::make_shared<TaskStepProgress>(next->getUid());
     m_task_progress.insert(next->getUid(), task_progress);
 
-    updateState();
+    queueStateUpdate();
 
     QMetaObject::invokeMethod(next.get(), &Task::start, Qt::QueuedConnection);
 }
@@ -165,8 +177,8 @@ void ConcurrentTask::subTaskFinished(Task::Ptr task, TaskStepState state)
 
     disconnect(task.get(), 0, this, 0);
 
-    emit stepProgress(task_progress);
-    updateState();
+    queueStepProgress(task_progress);
+    queueStateUpdate();
     QMetaObject::invokeMethod(this, &ConcurrentTask::executeNextSubTask, Qt::QueuedConnection);
 }
 
@@ -186,7 +198,7 @@ void ConcurrentTask::subTaskStatus(Task::Ptr task, const QString& msg)
     task_progress->status = msg;
     task_progress->state = TaskStepState::Running;
 
-    emit stepProgress(*task_progress);
+    queueStepProgress(*task_progress);
 
     if (totalSize() == 1) {
         setStatus(msg);
@@ -199,7 +211,7 @@ void ConcurrentTask::subTaskDetails(Task::Ptr task, const QString& msg)
     task_progress->details = msg;
     task_progress->state = TaskStepState::Running;
 
-    emit stepProgress(*task_progress);
+    queueStepProgress(*task_progress);
 
     if (totalSize() == 1) {
         setDetails(msg);
@@ -212,12 +224,68 @@ void ConcurrentTask::subTaskProgress(Task::Ptr task, qint64 current, qint64 tota
 
     task_progress->update(current, total);
 
-    emit stepProgress(*task_progress);
-    updateState();
+    queueStepProgress(*task_progress);
+}
 
-    if (totalSize() == 1) {
-        setProgress(task_progress->current, task_progress->total);
+void ConcurrentTask::queueStepProgress(const TaskStepProgress& task_progress)
+{
+    auto pending = m_pending_steps.find(task_progress.uid);
+    if (pending == m_pending_steps.end()) {
+        m_pending_steps.insert(task_progress.uid, task_progress);
+    } else {
+        // keep the values from before the first change we are coalescing
+        auto old_current = pending->old_current;
+        auto old_total = pending->old_total;
+        *pending = task_progress;
+        pending->old_current = old_current;
+        pending->old_total = old_total;
     }
+
+    if (!m_update_timer.isActive())
+        m_update_timer.start();
+}
+
+void ConcurrentTask::queueStateUpdate()
+{
+    m_state_pending = true;
+
+    if (!m_update_timer.isActive())
+        m_update_timer.start();
+}
+
+void ConcurrentTask::flushUpdates()
+{
+    m_update_timer.stop();
+
+    auto pending_steps = std::exchange(m_pending_steps, {});
+    for (auto const& task_progress : pending_steps) {
+        emit stepProgress(task_progress);
+
+        if (totalSize() == 1 && !task_progress.isDone()) {
+            setProgress(task_progress.current, task_progress.total);
+        }
+    }
+
+    if (std::exchange(m_state_pending, false))
+        updateState();
+}
+
+void ConcurrentTask::emitSucceeded()
+{
+    flushUpdates();
+    Task::emitSucceeded();
+}
+
+void ConcurrentTask::emitAborted()
+{
+    flushUpdates();
+    Task::emitAborted();
+}
+
+void ConcurrentTask::emitFailed(QString reason)
+{
+    flushUpdates();
+    Task::emitFailed(reason);
 }
 
 void ConcurrentTask::updateState()
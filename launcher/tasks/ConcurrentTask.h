@@ -38,6 +38,7 @@
 #include <QHash>
 #include <QQueue>
 #include <QSet>
+#include <QTimer>
 #include <QUuid>
 #include <memory>
 
@@ -81,6 +82,14 @@ class ConcurrentTask : public Task {
     void subTaskDetails(Task::Ptr task, const QString& msg);
     void subTaskProgress(Task::Ptr task, qint64 current, qint64 total);
 
+    void emitSucceeded() override;
+    void emitAborted() override;
+    void emitFailed(QString reason = "") override;
+
+    /** Emits the step progress and state changes accumulated since the last update.
+     */
+    void flushUpdates();
+
    protected:
     // NOTE: This is not thread-safe.
     [[nodiscard]] unsigned int totalSize() const { return static_cast<unsigned int>(m_queue.size() + m_doing.size() + m_done.size()); }
@@ -89,6 +98,14 @@ class ConcurrentTask : public Task {
 
     void startSubTask(Task::Ptr task);
 
+    /** Queues a step progress change to be emitted with the next update.
+     *  Subtasks can report progress many thousands of times, so we only forward it once per update interval.
+     */
+    void queueStepProgress(const TaskStepProgress& task_progress);
+    /** Marks the overall state (see updateState) as changed, to be refreshed with the next update.
+     */
+    void queueStateUpdate();
+
    protected:
     QQueue<Task::Ptr> m_queue;
 
@@ -100,4 +117,9 @@ class ConcurrentTask : public Task {
     QHash<QUuid, std::shared_ptr<TaskStepProgress>> m_task_progress;
 
     int m_total_max_size;
+
+   private:
+    QTimer m_update_timer;
+    QHash<QUuid, TaskStepProgress> m_pending_steps;
+    bool m_state_pending = false;
 };
@@ -43,7 +43,11 @@
 #include <QTimer>
 
 BlockedModsDialog::BlockedModsDialog(QWidget* parent, const QString& title, const QString& text, QList<BlockedMod>& mods, QString hash_type)
-    : QDialog(parent), ui(new Ui::BlockedModsDialog), m_mods(mods), m_hash_type(hash_type)
+    : QDialog(parent)
+    , ui(new Ui::BlockedModsDialog)
+    , m_mods(mods)
+    , m_hash_type(hash_type)
+    , m_hash_index(QDir("cache").absoluteFilePath("blocked_mods_hashes.json"))
 {
     m_hashing_task = shared_qobject_ptr<ConcurrentTask>(
         new ConcurrentTask(this, "MakeHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
@@ -121,6 +125,7 @@ void BlockedModsDialog::done(int r)
 {
     QDialog::done(r);
     disconnect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &BlockedModsDialog::directoryChanged);
+    m_hash_index.save();
 }
 
 void BlockedModsDialog::openAll(bool missingOnly)
@@ -231,17 +236,16 @@ void BlockedModsDialog::scanPaths()
     runHashTask();
 }
 
-/// @brief Scan the directory at path, skip paths that do not contain a file name
+/// @brief Scan the directory at path, skip paths that do not have the size or contain a file name
 ///        of a blocked mod we are looking for
 /// @param path the directory to scan
 void BlockedModsDialog::scanPath(QString path, bool start_task)
 {
-    QDir scan_dir(path);
     QDirIterator scan_it(path, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::NoIteratorFlags);
     while (scan_it.hasNext()) {
         QString file = scan_it.next();
 
-        if (!checkValidPath(file)) {
+        if (!checkValidSize(scan_it.fileInfo().size()) || !checkValidPath(file)) {
             continue;
         }
 
@@ -253,10 +257,15 @@ void BlockedModsDialog::scanPath(QString path, bool start_task)
     }
 }
 
-/// @brief add a hashing task for the file located at path, add the path to the pending set if the hashing task is already running
+/// @brief add a hashing task for the file located at path, add the path to the pending set if the hashing task is already running.
+///        Files that were already hashed and have not changed since are checked right away.
 /// @param path the path to the local file being hashed
 void BlockedModsDialog::addHashTask(QString path)
 {
+    if (auto hash = m_hash_index.hash(QFileInfo(path), m_hash_type); hash.has_value()) {
+        checkMatchHash(hash.value(), path);
+        return;
+    }
     qDebug() << "[Blocked Mods Dialog] adding a Hash task for" << path << "to the pending set.";
     m_pending_hash_paths.insert(path);
 }
@@ -270,7 +279,10 @@ void BlockedModsDialog::buildHashTask(QString path)
 
     qDebug() << "[Blocked Mods Dialog] Creating Hash task for path: " << path;
 
-    connect(hash_task.get(), &Task::succeeded, this, [this, hash_task, path] { checkMatchHash(hash_task->getResult(), path); });
+    connect(hash_task.get(), &Task::succeeded, this, [this, hash_task, path] {
+        m_hash_index.insert(QFileInfo(path), m_hash_type, hash_task->getResult());
+        checkMatchHash(hash_task->getResult(), path);
+    });
     connect(hash_task.get(), &Task::failed, this, [path] { qDebug() << "Failed to hash path: " << path; });
 
     m_hashing_task->addTask(hash_task);
@@ -365,6 +377,14 @@ bool BlockedModsDialog::checkValidPath(QString path)
     return false;
 }
 
+/// @brief Check if a file of this size can be one of the blocked mods we are still searching for
+/// @param size the size of the file in bytes
+/// @return boolean: is there a missing mod with this size, or one whose size is unknown?
+bool BlockedModsDialog::checkValidSize(qint64 size)
+{
+    return std::any_of(m_mods.begin(), m_mods.end(), [size](auto const& mod) { return !mod.matched && (mod.size == 0 || mod.size == size); });
+}
+
 bool BlockedModsDialog::allModsMatched()
 {
     return std::all_of(m_mods.begin(), m_mods.end(), [](auto const& mod) { return mod.matched; });
@@ -31,6 +31,7 @@
 
 #include <QFileSystemWatcher>
 
+#include "modplatform/helpers/FileHashIndex.h"
 #include "tasks/ConcurrentTask.h"
 
 class QPushButton;
@@ -39,6 +40,7 @@ struct BlockedMod {
     QString name;
     QString websiteUrl;
     QString hash;
+    qint64 size = 0;  // in bytes, 0 when unknown
     bool matched;
     QString localPath;
     QString targetFolder;
@@ -74,6 +76,7 @@ class BlockedModsDialog : public QDialog {
     bool m_rehash_pending;
     QPushButton* m_openMissingButton;
     QString m_hash_type;
+    FileHashIndex m_hash_index;
 
     void openAll(bool missingOnly);
     void addDownloadFolder();
@@ -91,6 +94,7 @@ class BlockedModsDialog : public QDialog {
     void hashTaskFinished();
 
     bool checkValidPath(QString path);
+    bool checkValidSize(qint64 size);
     bool allModsMatched();
 };
 
@@ -137,6 +137,7 @@ void ExportInstanceDialog::doExport()
     }
 
     SaveIcon(m_instance);
+    m_instance->settings()->flush();
 
     auto files = QFileInfoList();
     if (!MMCZip::collectFileListRecursively(m_instance->instanceRoot(), nullptr, &files,
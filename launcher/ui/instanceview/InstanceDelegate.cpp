@@ -123,33 +123,24 @@ void drawProgressOverlay(QPainter* painter, const QStyleOptionViewItem& option,
     painter->restore();
 }
 
-void drawBadges(QPainter* painter, const QStyleOptionViewItem& option, BaseInstance* instance, QIcon::Mode mode, QIcon::State state)
+void drawBadges(QPainter* painter, const QStyleOptionViewItem& option, const QList<QIcon>& pixmaps, QIcon::Mode mode, QIcon::State state)
 {
-    QList<QString> pixmaps;
-    if (instance->isRunning()) {
-        pixmaps.append("status-running");
-    } else if (instance->hasCrashed() || instance->hasVersionBroken()) {
-        pixmaps.append("status-bad");
-    }
-    if (instance->hasUpdateAvailable()) {
-        pixmaps.append("checkupdate");
+    if (pixmaps.isEmpty()) {
+        return;
     }
 
     static const int itemSide = 24;
     static const int spacing = 1;
     const int itemsPerRow = qMax(1, qFloor(double(option.rect.width() + spacing) / double(itemSide + spacing)));
     const int rows = qCeil((double)pixmaps.size() / (double)itemsPerRow);
-    QListIterator<QString> it(pixmaps);
+    QListIterator<QIcon> it(pixmaps);
     painter->translate(option.rect.topLeft());
     for (int y = 0; y < rows; ++y) {
         for (int x = 0; x < itemsPerRow; ++x) {
             if (!it.hasNext()) {
                 return;
             }
-            // FIXME: inject this.
-            auto icon = QIcon::fromTheme(it.next());
-            // opt.icon.paint(painter, iconbox, Qt::AlignCenter, mode, state);
-            const QPixmap pixmap;
+            const auto& icon = it.next();
             // itemSide
             QRect badgeRect(option.rect.width() - x * itemSide + qMax(x - 1, 0) * spacing - itemSide,
                             y * itemSide + qMax(y - 1, 0) * spacing, itemSide, itemSide);
@@ -176,6 +167,80 @@ static QSize viewItemTextSize(const QStyleOptionViewItem* option)
     return QSize(size.width() + 2 * textMargin, size.height());
 }
 
+static QString fontCacheKey(const QFont& font)
+{
+    // QFont::key() does not cover every property that affects the layout
+    return font.toString() + QLatin1Char('|') + font.key();
+}
+
+const ListViewDelegate::CachedTextLayout* ListViewDelegate::textLayout(const QStyleOptionViewItem& option, int width) const
+{
+    const QString key = QString("%1|%2|%3|%4").arg(width).arg(int(option.direction)).arg(fontCacheKey(option.font), option.text);
+    if (auto cached = m_textLayoutCache.object(key)) {
+        return cached;
+    }
+
+    auto entry = new CachedTextLayout;
+    QTextOption textOption;
+    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    textOption.setTextDirection(option.direction);
+    textOption.setAlignment(QStyle::visualAlignment(option.direction, option.displayAlignment));
+    entry->layout.setTextOption(textOption);
+    entry->layout.setFont(option.font);
+    entry->layout.setText(option.text);
+    entry->layout.setCacheEnabled(true);
+
+    qreal widthUsed;
+    viewItemTextLayout(entry->layout, width, entry->height, widthUsed);
+
+    m_textLayoutCache.insert(key, entry);
+    return m_textLayoutCache.object(key);
+}
+
+QSize ListViewDelegate::textSize(const QStyleOptionViewItem& option) const
+{
+    const QString key = fontCacheKey(option.font) + QLatin1Char('|') + option.text;
+    if (auto cached = m_textSizeCache.object(key)) {
+        return *cached;
+    }
+    auto size = viewItemTextSize(&option);
+    m_textSizeCache.insert(key, new QSize(size));
+    return size;
+}
+
+QPixmap ListViewDelegate::iconPixmap(const QIcon& icon, const QSize& size, qreal dpr, QIcon::Mode mode, QIcon::State state) const
+{
+    // the cache key of a QIcon changes whenever the icon does, so stale entries are simply never hit again
+    const QString key = QString("%1|%2x%3|%4|%5|%6").arg(icon.cacheKey()).arg(size.width()).arg(size.height()).arg(dpr).arg(mode).arg(state);
+    if (auto cached = m_iconCache.object(key)) {
+        return *cached;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPixmap pixmap = icon.pixmap(size, dpr, mode, state);
+#else
+    QPixmap pixmap = icon.pixmap(size * dpr, mode, state);
+    pixmap.setDevicePixelRatio(dpr);
+#endif
+    const int cost = qMax(1, pixmap.width() * pixmap.height() * 4 / 1024);
+    m_iconCache.insert(key, new QPixmap(pixmap), cost);
+    return pixmap;
+}
+
+QIcon ListViewDelegate::badgeIcon(const QString& name) const
+{
+    if (m_badgeTheme != QIcon::themeName()) {
+        m_badgeTheme = QIcon::themeName();
+        m_badgeIcons.clear();
+        m_iconCache.clear();
+    }
+    auto it = m_badgeIcons.constFind(name);
+    if (it == m_badgeIcons.constEnd()) {
+        it = m_badgeIcons.insert(name, QIcon::fromTheme(name));
+    }
+    return *it;
+}
+
 void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
     QStyleOptionViewItem opt = option;
@@ -273,7 +338,12 @@ void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
     // draw the icon
     {
         iconbox.setHeight(iconSize);
-        opt.icon.paint(painter, iconbox, Qt::AlignCenter, mode, state);
+        const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+        const QPixmap pixmap = iconPixmap(opt.icon, opt.icon.actualSize(iconbox.size(), mode, state), dpr, mode, state);
+        if (!pixmap.isNull()) {
+            const QRect pixmapRect = QStyle::alignedRect(opt.direction, Qt::AlignCenter, pixmap.size() / pixmap.devicePixelRatio(), iconbox);
+            painter->drawPixmap(pixmapRect, pixmap);
+        }
     }
     // set the text colors
     QPalette::ColorGroup cg = opt.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled;
@@ -286,31 +356,30 @@ void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
     }
 
     // draw the text
-    QTextOption textOption;
-    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-    textOption.setTextDirection(opt.direction);
-    textOption.setAlignment(QStyle::visualAlignment(opt.direction, opt.displayAlignment));
-    QTextLayout textLayout;
-    textLayout.setTextOption(textOption);
-    textLayout.setFont(opt.font);
-    textLayout.setText(opt.text);
+    const auto cachedLayout = textLayout(opt, textRect.width());
+    const int lineCount = cachedLayout->layout.lineCount();
 
-    qreal width, height;
-    viewItemTextLayout(textLayout, textRect.width(), height, width);
-
-    const int lineCount = textLayout.lineCount();
-
-    const QRect layoutRect = QStyle::alignedRect(opt.direction, opt.displayAlignment, QSize(textRect.width(), int(height)), textRect);
+    const QRect layoutRect =
+        QStyle::alignedRect(opt.direction, opt.displayAlignment, QSize(textRect.width(), int(cachedLayout->height)), textRect);
     const QPointF position = layoutRect.topLeft();
     for (int i = 0; i < lineCount; ++i) {
-        const QTextLine line = textLayout.lineAt(i);
+        const QTextLine line = cachedLayout->layout.lineAt(i);
         line.draw(painter, position);
     }
 
     // FIXME: this really has no business of being here. Make generic.
     auto instance = (BaseInstance*)index.data(InstanceList::InstancePointerRole).value<void*>();
     if (instance) {
-        drawBadges(painter, opt, instance, mode, state);
+        QList<QIcon> badges;
+        if (instance->isRunning()) {
+            badges.append(badgeIcon("status-running"));
+        } else if (instance->hasCrashed() || instance->hasVersionBroken()) {
+            badges.append(badgeIcon("status-bad"));
+        }
+        if (instance->hasUpdateAvailable()) {
+            badges.append(badgeIcon("checkupdate"));
+        }
+        drawBadges(painter, opt, badges, mode, state);
     }
 
     drawProgressOverlay(painter, opt, index.data(InstanceViewRoles::ProgressValueRole).toInt(),
@@ -331,7 +400,7 @@ QSize ListViewDelegate::sizeHint(const QStyleOptionViewItem& option, const QMode
     QStyle* style = opt.widget ? opt.widget->style() : QApplication::style();
     const int textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, &option, opt.widget) + 1;
     int height = 48 + textMargin * 2 + 5;  // TODO: turn constants into variables
-    QSize szz = viewItemTextSize(&opt);
+    QSize szz = textSize(opt);
     height += szz.height();
     // FIXME: maybe the icon items could scale and keep proportions?
     QSize sz(100, height);
@@ -16,7 +16,11 @@
 #pragma once
 
 #include <QCache>
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
 #include <QStyledItemDelegate>
+#include <QTextLayout>
 
 class ListViewDelegate : public QStyledItemDelegate {
     Q_OBJECT
@@ -35,4 +39,23 @@ class ListViewDelegate : public QStyledItemDelegate {
 
    private slots:
     void editingDone();
+
+   private:
+    struct CachedTextLayout {
+        QTextLayout layout;
+        qreal height = 0;
+    };
+
+    // the text of a tile is laid out once per (text, font, width, direction) and reused on repaint
+    const CachedTextLayout* textLayout(const QStyleOptionViewItem& option, int width) const;
+    QSize textSize(const QStyleOptionViewItem& option) const;
+    QPixmap iconPixmap(const QIcon& icon, const QSize& size, qreal dpr, QIcon::Mode mode, QIcon::State state) const;
+    QIcon badgeIcon(const QString& name) const;
+
+    mutable QCache<QString, CachedTextLayout> m_textLayoutCache{ 1024 };
+    mutable QCache<QString, QSize> m_textSizeCache{ 1024 };
+    // cost is in kilobytes of pixel data
+    mutable QCache<QString, QPixmap> m_iconCache{ 32 * 1024 };
+    mutable QHash<QString, QIcon> m_badgeIcons;
+    mutable QString m_badgeTheme;
 };
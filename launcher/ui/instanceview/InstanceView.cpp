@@ -49,6 +49,7 @@
 #include <QtMath>
 
 #include "VisualGroup.h"
+#include "settings/Setting.h"
 #include "ui/themes/ThemeManager.h"
 
 #include <Application.h>
@@ -72,12 +73,21 @@ InstanceView::InstanceView(QWidget* parent) : QAbstractItemView(parent)
     setAcceptDrops(true);
     setAutoScroll(true);
     setPaintCat(APPLICATION->settings()->get("TheCat").toBool());
+    auto catOpacity = APPLICATION->settings()->getSetting("CatOpacity");
+    auto updateCatOpacity = [this] {
+        m_catOpacity = APPLICATION->settings()->get("CatOpacity").toFloat() / 100;
+        if (m_catVisible)
+            viewport()->update();
+    };
+    connect(catOpacity.get(), &Setting::SettingChanged, this, updateCatOpacity);
+    connect(catOpacity.get(), &Setting::settingReset, this, updateCatOpacity);
 }
 
 InstanceView::~InstanceView()
 {
     qDeleteAll(m_groups);
     m_groups.clear();
+    m_groupIndex.clear();
 }
 
 void InstanceView::setModel(QAbstractItemModel* model)
@@ -87,30 +97,82 @@ void InstanceView::setModel(QAbstractItemModel* model)
     connect(model, &QAbstractItemModel::rowsRemoved, this, &InstanceView::rowsRemoved);
 }
 
-void InstanceView::dataChanged([[maybe_unused]] const QModelIndex& topLeft,
-                               [[maybe_unused]] const QModelIndex& bottomRight,
-                               [[maybe_unused]] const QVector<int>& roles)
+void InstanceView::scheduleFullLayout()
 {
+    m_layoutPending = true;
     scheduleDelayedItemsLayout();
 }
+
+void InstanceView::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+    // a full layout is coming anyway, the rows may not match the last one
+    if (m_layoutPending || m_rowGroups.size() != model()->rowCount()) {
+        scheduleFullLayout();
+        return;
+    }
+
+    bool groupsChanged = false;
+    for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+        const QModelIndex index = model()->index(row, 0);
+        const QString groupName = index.data(InstanceViewRoles::GroupRole).toString();
+        geometryCache.remove(row);
+
+        const QString oldGroupName = m_rowGroups[row];
+        if (groupName != oldGroupName) {
+            // moved to another group
+            if (auto oldGroup = m_groupIndex.value(oldGroupName)) {
+                oldGroup->removeItem(row);
+                if (oldGroup->indices.isEmpty()) {
+                    removeCategory(oldGroup);
+                }
+            }
+            auto group = m_groupIndex.value(groupName);
+            if (!group) {
+                group = createCategory(groupName);
+            }
+            group->insertItem(index);
+            m_rowGroups[row] = groupName;
+            groupsChanged = true;
+            continue;
+        }
+
+        auto group = m_groupIndex.value(groupName);
+        if (!group) {
+            scheduleFullLayout();
+            return;
+        }
+        if (group->itemHeightChanged(index)) {
+            group->dirty = true;
+            groupsChanged = true;
+        }
+    }
+
+    if (groupsChanged && !m_groupUpdateQueued) {
+        m_groupUpdateQueued = true;
+        QMetaObject::invokeMethod(this, &InstanceView::updateDirtyGroups, Qt::QueuedConnection);
+    }
+    // repaints the changed items
+    QAbstractItemView::dataChanged(topLeft, bottomRight, roles);
+}
+
 void InstanceView::rowsInserted([[maybe_unused]] const QModelIndex& parent, [[maybe_unused]] int start, [[maybe_unused]] int end)
 {
-    scheduleDelayedItemsLayout();
+    scheduleFullLayout();
 }
 
 void InstanceView::rowsAboutToBeRemoved([[maybe_unused]] const QModelIndex& parent, [[maybe_unused]] int start, [[maybe_unused]] int end)
 {
-    scheduleDelayedItemsLayout();
+    scheduleFullLayout();
 }
 
 void InstanceView::modelReset()
 {
-    scheduleDelayedItemsLayout();
+    scheduleFullLayout();
 }
 
 void InstanceView::rowsRemoved()
 {
-    scheduleDelayedItemsLayout();
+    scheduleFullLayout();
 }
 
 void InstanceView::currentChanged(const QModelIndex& current, const QModelIndex& previous)
@@ -173,34 +235,102 @@ void InstanceView::updateScrollbar()
 void InstanceView::updateGeometries()
 {
     geometryCache.clear();
+    m_layoutPending = false;
 
-    QMap<LocaleString, VisualGroup*> cats;
+    // sort the items into their groups in one pass over the model
+    const int rowCount = model() ? model()->rowCount() : 0;
+    QMap<LocaleString, QList<QModelIndex>> groupItems;
+    m_rowGroups.resize(rowCount);
+    for (int i = 0; i < rowCount; ++i) {
+        const QModelIndex index = model()->index(i, 0);
+        const QString groupName = index.data(InstanceViewRoles::GroupRole).toString();
+        m_rowGroups[i] = groupName;
+        groupItems[groupName].append(index);
+    }
 
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        const QString groupName = model()->index(i, 0).data(InstanceViewRoles::GroupRole).toString();
-        if (!cats.contains(groupName)) {
-            VisualGroup* old = this->category(groupName);
-            if (old) {
-                auto cat = new VisualGroup(old);
-                cats.insert(groupName, cat);
-                cat->update();
-            } else {
-                auto cat = new VisualGroup(groupName, this);
-                if (fVisibility) {
-                    cat->collapsed = fVisibility(groupName);
-                }
-                cats.insert(groupName, cat);
-                cat->update();
+    // keep the existing groups, so their state (and pointers to them) survive
+    auto oldGroups = m_groupIndex;
+    m_groups.clear();
+    m_groupIndex.clear();
+    for (auto it = groupItems.begin(); it != groupItems.end(); it++) {
+        auto group = oldGroups.take(it.key());
+        if (!group) {
+            group = new VisualGroup(it.key(), this);
+            if (fVisibility) {
+                group->collapsed = fVisibility(it.key());
             }
         }
+        group->indices = it.value();
+        group->update();
+        m_groups.append(group);
+        m_groupIndex.insert(it.key(), group);
+    }
+    for (auto group : oldGroups) {
+        if (m_pressedCategory == group) {
+            m_pressedCategory = nullptr;
+        }
+        delete group;
     }
 
-    qDeleteAll(m_groups);
-    m_groups = cats.values();
     updateScrollbar();
     viewport()->update();
 }
 
+void InstanceView::updateDirtyGroups()
+{
+    m_groupUpdateQueued = false;
+    if (m_layoutPending) {
+        return;
+    }
+    bool heightChanged = false;
+    for (auto group : m_groups) {
+        if (!group->dirty) {
+            continue;
+        }
+        const int oldHeight = group->totalHeight();
+        group->update();
+        if (group->totalHeight() != oldHeight) {
+            heightChanged = true;
+        } else {
+            for (auto& index : group->indices) {
+                geometryCache.remove(index.row());
+            }
+        }
+    }
+    // the groups below moved
+    if (heightChanged) {
+        geometryCache.clear();
+    }
+    updateScrollbar();
+    viewport()->update();
+}
+
+VisualGroup* InstanceView::createCategory(const QString& name)
+{
+    auto group = new VisualGroup(name, this);
+    if (fVisibility) {
+        group->collapsed = fVisibility(name);
+    }
+    // keep the groups sorted the same way a full layout does
+    auto pos = std::lower_bound(m_groups.begin(), m_groups.end(), name,
+                                [](const VisualGroup* a, const QString& b) { return LocaleString(a->text) < LocaleString(b); });
+    m_groups.insert(pos, group);
+    m_groupIndex.insert(name, group);
+    geometryCache.clear();
+    return group;
+}
+
+void InstanceView::removeCategory(VisualGroup* group)
+{
+    if (m_pressedCategory == group) {
+        m_pressedCategory = nullptr;
+    }
+    m_groups.removeOne(group);
+    m_groupIndex.remove(group->text);
+    geometryCache.clear();
+    delete group;
+}
+
 bool InstanceView::isIndexHidden(const QModelIndex& index) const
 {
     VisualGroup* cat = category(index);
@@ -218,12 +348,7 @@ VisualGroup* InstanceView::category(const QModelIndex& index) const
 
 VisualGroup* InstanceView::category(const QString& cat) const
 {
-    for (auto group : m_groups) {
-        if (group->text == cat) {
-            return group;
-        }
-    }
-    return nullptr;
+    return m_groupIndex.value(cat, nullptr);
 }
 
 VisualGroup* InstanceView::categoryAt(const QPoint& pos, VisualGroup::HitResults& result) const
@@ -449,6 +574,11 @@ void InstanceView::setPaintCat(bool visible)
         m_catPixmap.load(APPLICATION->themeManager()->getCatPack());
     else
         m_catPixmap = QPixmap();
+    m_catOpacity = APPLICATION->settings()->get("CatOpacity").toFloat() / 100;
+    m_scaledCatPixmap = QPixmap();
+    m_scaledCatViewport = QSize();
+    m_scaledCatDpr = 0;
+    viewport()->update();
 }
 
 void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
@@ -457,18 +587,23 @@ void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
 
     QPainter painter(this->viewport());
 
-    if (m_catVisible) {
-        painter.setOpacity(APPLICATION->settings()->get("CatOpacity").toFloat() / 100);
-        int widWidth = this->viewport()->width();
-        int widHeight = this->viewport()->height();
-        if (m_catPixmap.width() < widWidth)
-            widWidth = m_catPixmap.width();
-        if (m_catPixmap.height() < widHeight)
-            widHeight = m_catPixmap.height();
-        auto pixmap = m_catPixmap.scaled(widWidth, widHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        QRect rectOfPixmap = pixmap.rect();
+    if (m_catVisible && !m_catPixmap.isNull()) {
+        const QSize viewportSize = this->viewport()->size();
+        const qreal dpr = this->viewport()->devicePixelRatioF();
+        if (m_scaledCatViewport != viewportSize || m_scaledCatDpr != dpr) {
+            // never larger than the image itself, in logical pixels, then rendered in device pixels to stay sharp
+            QSize logicalSize = viewportSize.boundedTo(m_catPixmap.size());
+            int widWidth = qCeil(logicalSize.width() * dpr);
+            int widHeight = qCeil(logicalSize.height() * dpr);
+            m_scaledCatPixmap = m_catPixmap.scaled(widWidth, widHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            m_scaledCatPixmap.setDevicePixelRatio(dpr);
+            m_scaledCatViewport = viewportSize;
+            m_scaledCatDpr = dpr;
+        }
+        painter.setOpacity(m_catOpacity);
+        QRect rectOfPixmap(QPoint(), m_scaledCatPixmap.size() / dpr);
         rectOfPixmap.moveBottomRight(this->viewport()->rect().bottomRight());
-        painter.drawPixmap(rectOfPixmap.topLeft(), pixmap);
+        painter.drawPixmap(rectOfPixmap.topLeft(), m_scaledCatPixmap);
         painter.setOpacity(1.0);
     }
 
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <QCache>
+#include <QHash>
 #include <QLineEdit>
 #include <QListView>
 #include <QScrollBar>
@@ -112,9 +113,18 @@ class InstanceView : public QAbstractItemView {
 
     void updateScrollbar();
 
+   private slots:
+    /// lay out again only the groups that were marked dirty since the last layout
+    void updateDirtyGroups();
+
    private:
     friend struct VisualGroup;
     QList<VisualGroup*> m_groups;
+    QHash<QString, VisualGroup*> m_groupIndex;
+    /// group of each model row, as of the last layout
+    QVector<QString> m_rowGroups;
+    bool m_layoutPending = true;
+    bool m_groupUpdateQueued = false;
 
     visibilityFunction fVisibility;
 
@@ -130,18 +140,26 @@ class InstanceView : public QAbstractItemView {
     mutable QCache<int, QRect> geometryCache;
     bool m_catVisible = false;
     QPixmap m_catPixmap;
+    // m_catPixmap scaled to fit the viewport, rebuilt only when the viewport size or pixel ratio changes
+    QPixmap m_scaledCatPixmap;
+    QSize m_scaledCatViewport;
+    qreal m_scaledCatDpr = 0;
+    qreal m_catOpacity = 1.0;
 
     // point where the currently active mouse action started in geometry coordinates
     QPoint m_pressedPosition;
     QPersistentModelIndex m_pressedIndex;
     bool m_pressedAlreadySelected;
-    VisualGroup* m_pressedCategory;
+    VisualGroup* m_pressedCategory = nullptr;
     QItemSelectionModel::SelectionFlag m_ctrlDragSelectionFlag;
     QPoint m_lastDragPosition;
 
     VisualGroup* category(const QModelIndex& index) const;
     VisualGroup* category(const QString& cat) const;
     VisualGroup* categoryAt(const QPoint& pos, VisualGroup::HitResults& result) const;
+    VisualGroup* createCategory(const QString& name);
+    void removeCategory(VisualGroup* group);
+    void scheduleFullLayout();
 
     int itemsPerRow() const { return m_currentItemsPerRow; };
     int contentWidth() const;
@@ -41,13 +41,48 @@
 #include <QModelIndex>
 #include <QPainter>
 #include <QtMath>
+#include <algorithm>
 #include <utility>
 
 #include "InstanceView.h"
 
 VisualGroup::VisualGroup(QString text, InstanceView* view) : view(view), text(std::move(text)), collapsed(false) {}
 
-VisualGroup::VisualGroup(const VisualGroup* other) : view(other->view), text(other->text), collapsed(other->collapsed) {}
+int VisualGroup::itemHeight(const QModelIndex& index) const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QStyleOptionViewItem viewItemOption;
+    view->initViewItemOption(&viewItemOption);
+#else
+    QStyleOptionViewItem viewItemOption = view->viewOptions();
+#endif
+    return view->itemDelegate()->sizeHint(viewItemOption, index).height();
+}
+
+bool VisualGroup::itemHeightChanged(const QModelIndex& index) const
+{
+    auto height = itemHeights.find(index.row());
+    return height == itemHeights.end() || *height != itemHeight(index);
+}
+
+void VisualGroup::insertItem(const QModelIndex& index)
+{
+    auto pos = std::lower_bound(indices.begin(), indices.end(), index,
+                                [](const QModelIndex& a, const QModelIndex& b) { return a.row() < b.row(); });
+    indices.insert(pos, index);
+    dirty = true;
+}
+
+void VisualGroup::removeItem(int row)
+{
+    for (auto it = indices.begin(); it != indices.end(); it++) {
+        if (it->row() == row) {
+            indices.erase(it);
+            dirty = true;
+            return;
+        }
+    }
+}
 
 void VisualGroup::update()
 {
@@ -56,6 +91,9 @@ void VisualGroup::update()
 
     int numRows = qMax(1, qCeil((qreal)temp_items.size() / (qreal)itemsPerRow));
     rows = QVector<VisualRow>(numRows);
+    positions.clear();
+    itemHeights.clear();
+    dirty = false;
 
     int maxRowHeight = 0;
     int positionInRow = 0;
@@ -73,17 +111,12 @@ void VisualGroup::update()
             positionInRow = 0;
             maxRowHeight = 0;
         }
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        QStyleOptionViewItem viewItemOption;
-        view->initViewItemOption(&viewItemOption);
-#else
-        QStyleOptionViewItem viewItemOption = view->viewOptions();
-#endif
-
-        auto itemHeight = view->itemDelegate()->sizeHint(viewItemOption, item).height();
-        if (itemHeight > maxRowHeight) {
-            maxRowHeight = itemHeight;
+        auto height = itemHeight(item);
+        if (height > maxRowHeight) {
+            maxRowHeight = height;
         }
+        positions.insert(item.row(), qMakePair(positionInRow, currentRow));
+        itemHeights.insert(item.row(), height);
         rows[currentRow].items.append(item);
         positionInRow++;
     }
@@ -93,14 +126,9 @@ void VisualGroup::update()
 
 QPair<int, int> VisualGroup::positionOf(const QModelIndex& index) const
 {
-    int y = 0;
-    for (auto& row : rows) {
-        for (auto x = 0; x < row.items.size(); x++) {
-            if (row.items[x] == index) {
-                return qMakePair(x, y);
-            }
-        }
-        y++;
+    auto position = positions.find(index.row());
+    if (position != positions.end()) {
+        return *position;
     }
     qWarning() << "Item" << index.row() << index.data(Qt::DisplayRole).toString() << "not found in visual group" << text;
     return qMakePair(0, 0);
@@ -258,12 +286,5 @@ int VisualGroup::verticalPosition() const
 
 QList<QModelIndex> VisualGroup::items() const
 {
-    QList<QModelIndex> indices;
-    for (int i = 0; i < view->model()->rowCount(); ++i) {
-        const QModelIndex index = view->model()->index(i, 0);
-        if (index.data(InstanceViewRoles::GroupRole).toString() == text) {
-            indices.append(index);
-        }
-    }
     return indices;
 }
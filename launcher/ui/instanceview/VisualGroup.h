@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <QHash>
+#include <QModelIndex>
 #include <QRect>
 #include <QString>
 #include <QStyleOption>
@@ -42,7 +44,6 @@
 
 class InstanceView;
 class QPainter;
-class QModelIndex;
 
 struct VisualRow {
     QList<QModelIndex> items;
@@ -55,7 +56,6 @@ struct VisualRow {
 struct VisualGroup {
     /* constructors */
     VisualGroup(QString text, InstanceView* view);
-    explicit VisualGroup(const VisualGroup* other);
 
     /* data */
     InstanceView* view = nullptr;
@@ -64,11 +64,23 @@ struct VisualGroup {
     QVector<VisualRow> rows;
     int firstItemIndex = 0;
     int m_verticalPosition = 0;
+    /// the items of the group, in model order
+    QList<QModelIndex> indices;
+    /// needs to flow its items into rows again
+    bool dirty = true;
 
     /* logic */
-    /// update the internal list of items and flow them into the rows.
+    /// flow the items into the rows.
     void update();
 
+    /// add an item to the group, keeping the model order. Marks the group dirty.
+    void insertItem(const QModelIndex& index);
+    /// remove the item at the given model row from the group. Marks the group dirty.
+    void removeItem(int row);
+
+    /// check if the height of the item differs from the one it was laid out with
+    bool itemHeightChanged(const QModelIndex& index) const;
+
     /// draw the header at y-position.
     void drawHeader(QPainter* painter, const QStyleOptionViewItem& option) const;
 
@@ -106,6 +118,14 @@ struct VisualGroup {
     HitResults hitScan(const QPoint& pos) const;
 
     QList<QModelIndex> items() const;
+
+   private:
+    int itemHeight(const QModelIndex& index) const;
+
+    /// position (column, row) of each item by model row, as of the last update
+    QHash<int, QPair<int, int>> positions;
+    /// height of each item by model row, as of the last update
+    QHash<int, int> itemHeights;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(VisualGroup::HitResults)
@@ -40,9 +40,12 @@
 #include "ui_ScreenshotsPage.h"
 
 #include <QClipboard>
+#include <QCryptographicHash>
+#include <QDirIterator>
 #include <QEvent>
 #include <QFileIconProvider>
 #include <QFileSystemModel>
+#include <QImageReader>
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QMap>
@@ -51,8 +54,11 @@
 #include <QMutableListIterator>
 #include <QPainter>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QSet>
 #include <QStyledItemDelegate>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 #include <Application.h>
 
@@ -71,6 +77,28 @@
 using SharedIconCache = RWStorage<QString, QIcon>;
 using SharedIconCachePtr = std::shared_ptr<SharedIconCache>;
 
+// thumbnails that were not used for this long are deleted, they likely belong to screenshots that are gone
+static constexpr int THUMBNAIL_MAX_AGE_DAYS = 30;
+
+/// the key changes whenever the screenshot is replaced, so stale thumbnails are never picked up
+static QString thumbnailPathFor(const QString& thumbnailDir, const QString& path, qint64 size, const QDateTime& lastModified)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QString("%1|%2|%3").arg(QFileInfo(path).absoluteFilePath()).arg(size).arg(lastModified.toMSecsSinceEpoch()).toUtf8());
+    return FS::PathCombine(thumbnailDir, QString::fromLatin1(hash.result().toHex()) + ".png");
+}
+
+static void pruneThumbnails(const QString& thumbnailDir)
+{
+    auto oldest = QDateTime::currentDateTime().addDays(-THUMBNAIL_MAX_AGE_DAYS);
+    QDirIterator it(thumbnailDir, { "*.png" }, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileInfo().lastModified() < oldest)
+            QFile::remove(it.filePath());
+    }
+}
+
 class ThumbnailingResult : public QObject {
     Q_OBJECT
    public slots:
@@ -83,31 +111,64 @@ class ThumbnailingResult : public QObject {
 
 class ThumbnailRunnable : public QRunnable {
    public:
-    ThumbnailRunnable(QString path, SharedIconCachePtr cache)
+    ThumbnailRunnable(QString path, QString thumbnailDir, SharedIconCachePtr cache)
     {
         m_path = path;
+        m_thumbnailDir = thumbnailDir;
         m_cache = cache;
     }
     void run()
     {
+        // every exit reports back, the model only queues the path again once it heard about it
         QFileInfo info(m_path);
-        if (info.isDir())
-            return;
-        if ((info.suffix().compare("png", Qt::CaseInsensitive) != 0))
+        if (info.isDir() || (info.suffix().compare("png", Qt::CaseInsensitive) != 0)) {
+            m_resultEmitter.emitResultsFailed(m_path);
             return;
-        if (!m_cache->stale(m_path))
+        }
+        if (!m_cache->stale(m_path)) {
+            m_resultEmitter.emitResultsReady(m_path);
             return;
-        QImage image(m_path);
+        }
+
+        const QString thumbnailPath = thumbnailPathFor(m_thumbnailDir, m_path, info.size(), info.lastModified());
+
+        QImage square(thumbnailPath);
+        if (!square.isNull()) {
+            // keep thumbnails that are still in use from expiring, at most once a day
+            QFile file(thumbnailPath);
+            auto now = QDateTime::currentDateTime();
+            if (QFileInfo(thumbnailPath).lastModified().daysTo(now) >= 1 && file.open(QIODevice::ReadWrite))
+                file.setFileTime(now, QFileDevice::FileModificationTime);
+        } else {
+            square = createThumbnail();
+            if (square.isNull()) {
+                m_resultEmitter.emitResultsFailed(m_path);
+                return;
+            }
+            if (FS::ensureFilePathExists(thumbnailPath)) {
+                QSaveFile file(thumbnailPath);
+                if (!file.open(QIODevice::WriteOnly) || !square.save(&file, "PNG") || !file.commit())
+                    qWarning() << "Failed to write the screenshot thumbnail" << thumbnailPath;
+            }
+        }
+
+        QIcon icon(QPixmap::fromImage(square));
+        m_cache->add(m_path, icon);
+        m_resultEmitter.emitResultsReady(m_path);
+    }
+    QImage createThumbnail()
+    {
+        QImageReader reader(m_path);
+        const QSize size = reader.size();
+        // let the reader downscale while decoding where the format supports it, instead of keeping the full image around
+        if (size.isValid() && (size.width() > 512 || size.height() > 512))
+            reader.setScaledSize(size.scaled(512, 512, Qt::KeepAspectRatio));
+        QImage image = reader.read();
         if (image.isNull()) {
-            m_resultEmitter.emitResultsFailed(m_path);
-            qDebug() << "Error loading screenshot: " + m_path + ". Perhaps too large?";
-            return;
+            qDebug() << "Error loading screenshot: " + m_path + ". Perhaps too large?" << reader.errorString();
+            return {};
         }
-        QImage small;
-        if (image.width() > image.height())
-            small = image.scaledToWidth(512).scaledToWidth(256, Qt::SmoothTransformation);
-        else
-            small = image.scaledToHeight(512).scaledToHeight(256, Qt::SmoothTransformation);
+        QImage small = image.scaled(256, 256, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         QPoint offset((256 - small.width()) / 2, (256 - small.height()) / 2);
         QImage square(QSize(256, 256), QImage::Format_ARGB32);
         square.fill(Qt::transparent);
@@ -115,12 +176,10 @@ class ThumbnailRunnable : public QRunnable {
         QPainter painter(&square);
         painter.drawImage(offset, small);
         painter.end();
-
-        QIcon icon(QPixmap::fromImage(square));
-        m_cache->add(m_path, icon);
-        m_resultEmitter.emitResultsReady(m_path);
+        return square;
     }
     QString m_path;
+    QString m_thumbnailDir;
     SharedIconCachePtr m_cache;
     ThumbnailingResult m_resultEmitter;
 };
@@ -130,12 +189,24 @@ class ThumbnailRunnable : public QRunnable {
 class FilterModel : public QIdentityProxyModel {
     Q_OBJECT
    public:
-    explicit FilterModel(QObject* parent = 0) : QIdentityProxyModel(parent)
+    explicit FilterModel(QString folder, QObject* parent = 0) : QIdentityProxyModel(parent)
     {
         m_thumbnailingPool.setMaxThreadCount(4);
         m_thumbnailCache = std::make_shared<SharedIconCache>();
         m_thumbnailCache->add("placeholder", APPLICATION->getThemedIcon("screenshot-placeholder"));
-        connect(&watcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
+        m_thumbnailDir = FS::PathCombine("cache", "screenshots");
+        // once per run is plenty, the folder only grows slowly
+        static bool pruned = false;
+        if (!pruned) {
+            pruned = true;
+            QtConcurrent::run(&m_thumbnailingPool, [dir = m_thumbnailDir] { pruneThumbnails(dir); });
+        }
+        // one watcher on the folder instead of one per screenshot
+        watcher.addPath(folder);
+        connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &FilterModel::directoryChanged);
+        m_updateTimer.setSingleShot(true);
+        m_updateTimer.setInterval(16);
+        connect(&m_updateTimer, &QTimer::timeout, this, &FilterModel::flushUpdates);
     }
     virtual ~FilterModel()
     {
@@ -156,10 +227,6 @@ class FilterModel : public QIdentityProxyModel {
             QVariant result = sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole);
             QString filePath = result.toString();
             QIcon temp;
-            if (!watched.contains(filePath)) {
-                ((QFileSystemWatcher&)watcher).addPath(filePath);
-                ((QSet<QString>&)watched).insert(filePath);
-            }
             if (m_thumbnailCache->get(filePath, temp)) {
                 return temp;
             }
@@ -189,30 +256,89 @@ class FilterModel : public QIdentityProxyModel {
    private:
     void thumbnailImage(QString path)
     {
-        auto runnable = new ThumbnailRunnable(path, m_thumbnailCache);
+        // data() is called repeatedly while the thumbnail is being made, only queue it once
+        if (m_queued.contains(path))
+            return;
+        m_queued.insert(path);
+        QFileInfo info(path);
+        m_thumbnailed[path] = { info.size(), info.lastModified() };
+        auto runnable = new ThumbnailRunnable(path, m_thumbnailDir, m_thumbnailCache);
         connect(&(runnable->m_resultEmitter), SIGNAL(resultsReady(QString)), SLOT(thumbnailReady(QString)));
         connect(&(runnable->m_resultEmitter), SIGNAL(resultsFailed(QString)), SLOT(thumbnailFailed(QString)));
         ((QThreadPool&)m_thumbnailingPool).start(runnable);
     }
    private slots:
-    void thumbnailReady(QString path) { emit layoutChanged(); }
-    void thumbnailFailed(QString path) { m_failed.insert(path); }
-    void fileChanged(QString filepath)
+    void thumbnailReady(QString path)
     {
-        m_thumbnailCache->setStale(filepath);
-        // reinsert the path...
-        watcher.removePath(filepath);
-        if (QFile::exists(filepath)) {
-            watcher.addPath(filepath);
-            thumbnailImage(filepath);
+        m_queued.remove(path);
+        m_updated.insert(path);
+        // collect the thumbnails finished within a frame into one update
+        if (!m_updateTimer.isActive())
+            m_updateTimer.start();
+    }
+    void thumbnailFailed(QString path)
+    {
+        m_queued.remove(path);
+        m_failed.insert(path);
+    }
+    void flushUpdates()
+    {
+        auto model = qobject_cast<QFileSystemModel*>(sourceModel());
+        if (!model) {
+            m_updated.clear();
+            return;
+        }
+        int first = -1;
+        int last = -1;
+        for (auto& path : m_updated) {
+            auto proxyIndex = mapFromSource(model->index(path));
+            if (!proxyIndex.isValid())
+                continue;
+            first = first == -1 ? proxyIndex.row() : std::min(first, proxyIndex.row());
+            last = std::max(last, proxyIndex.row());
+        }
+        m_updated.clear();
+        if (first != -1)
+            emit dataChanged(index(first, 0), index(last, 0), { Qt::DecorationRole });
+    }
+    void directoryChanged(QString)
+    {
+        // the folder watcher does not tell which screenshot changed, so compare the ones we have thumbnails for
+        for (auto it = m_thumbnailed.begin(); it != m_thumbnailed.end();) {
+            QFileInfo info(it.key());
+            if (!info.exists() || info.lastModified() != it->lastModified || info.size() != it->size) {
+                // nothing will ask for the old thumbnail again
+                QFile::remove(thumbnailPathFor(m_thumbnailDir, it.key(), it->size, it->lastModified));
+            }
+            if (!info.exists()) {
+                m_thumbnailCache->setStale(it.key());
+                m_failed.remove(it.key());
+                it = m_thumbnailed.erase(it);
+                continue;
+            }
+            if (info.lastModified() != it->lastModified || info.size() != it->size) {
+                m_thumbnailCache->setStale(it.key());
+                m_failed.remove(it.key());
+                thumbnailImage(it.key());
+            }
+            ++it;
         }
     }
 
    private:
     SharedIconCachePtr m_thumbnailCache;
+    QString m_thumbnailDir;
     QThreadPool m_thumbnailingPool;
     QSet<QString> m_failed;
-    QSet<QString> watched;
+    QSet<QString> m_queued;
+    QSet<QString> m_updated;
+    struct Snapshot {
+        qint64 size = 0;
+        QDateTime lastModified;
+    };
+    /// the screenshots that were thumbnailed, as they were at the time
+    QHash<QString, Snapshot> m_thumbnailed;
+    QTimer m_updateTimer;
     QFileSystemWatcher watcher;
 };
 
@@ -235,8 +361,11 @@ class CenteredEditingDelegate : public QStyledItemDelegate {
 
 ScreenshotsPage::ScreenshotsPage(QString path, QWidget* parent) : QMainWindow(parent), ui(new Ui::ScreenshotsPage)
 {
+    m_folder = path;
+    m_valid = FS::ensureFolderPathExists(m_folder);
+
     m_model.reset(new QFileSystemModel());
-    m_filterModel.reset(new FilterModel());
+    m_filterModel.reset(new FilterModel(m_folder));
     m_filterModel->setSourceModel(m_model.get());
     m_model->setFilter(QDir::Files);
     m_model->setReadOnly(false);
@@ -247,9 +376,6 @@ ScreenshotsPage::ScreenshotsPage(QString path, QWidget* parent) : QMainWindow(pa
     constexpr int file_modified_column_index = 3;
     m_model->sort(file_modified_column_index, Qt::DescendingOrder);
 
-    m_folder = path;
-    m_valid = FS::ensureFolderPathExists(m_folder);
-
     ui->setupUi(this);
     ui->toolBar->insertSpacer(ui->actionView_Folder);
 
@@ -5,11 +5,17 @@
 #include "ResourceModel.h"
 
 #include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QIcon>
+#include <QImageReader>
 #include <QList>
 #include <QMessageBox>
-#include <QPixmapCache>
+#include <QSaveFile>
+#include <QThreadPool>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <algorithm>
 #include <memory>
 
@@ -31,6 +37,9 @@ QHash<ResourceModel*, bool> ResourceModel::s_running_models;
 ResourceModel::ResourceModel(ResourceAPI* api) : QAbstractListModel(), m_api(api)
 {
     s_running_models.insert(this, true);
+    m_icon_update_timer.setSingleShot(true);
+    m_icon_update_timer.setInterval(16);
+    connect(&m_icon_update_timer, &QTimer::timeout, this, &ResourceModel::flushIconUpdates);
 #ifndef LAUNCHER_TEST
     m_current_info_job.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt());
 #endif
@@ -60,7 +69,7 @@ auto ResourceModel::data(const QModelIndex& index, int role) const -> QVariant
             return pack->description;
         }
         case Qt::DecorationRole: {
-            if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(const_cast<QModelIndex&>(index), pack->logoUrl);
+            if (auto icon_or_none = const_cast<ResourceModel*>(this)->getIcon(pack->logoUrl);
                 icon_or_none.has_value())
                 return icon_or_none.value();
 
@@ -311,17 +320,40 @@ std::optional<ResourceAPI::SortingMethod> ResourceModel::getCurrentSortingMethod
     return sort;
 }
 
-std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
+namespace {
+// the list shows icons at 48x48, leave some room for high DPI screens
+constexpr int iconSize = 96;
+
+QImage loadIconImage(const QString& path, const QString& thumbnail_path, bool regenerate)
 {
-    QPixmap pixmap;
-    if (QPixmapCache::find(url.toString(), &pixmap))
-        return { pixmap };
+    if (!regenerate) {
+        QImage thumbnail(thumbnail_path);
+        if (!thumbnail.isNull())
+            return thumbnail;
+    }
 
-    if (!m_current_icon_job) {
-        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
-        m_current_icon_job->setAskRetry(false);
+    QImageReader reader(path);
+    auto size = reader.size();
+    if (size.isValid() && (size.width() > iconSize || size.height() > iconSize))
+        reader.setScaledSize(size.scaled(iconSize, iconSize, Qt::KeepAspectRatio));
+    auto image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Failed to decode icon" << path << ":" << reader.errorString();
+        return image;
     }
 
+    QSaveFile file(thumbnail_path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit())
+        qWarning() << "Failed to write icon thumbnail" << thumbnail_path;
+    return image;
+}
+}  // namespace
+
+std::optional<QIcon> ResourceModel::getIcon(const QUrl& url)
+{
+    if (auto pixmap = m_icon_cache.object(url))
+        return { *pixmap };
+
     if (m_currently_running_icon_actions.contains(url))
         return {};
     if (m_failed_icon_actions.contains(url))
@@ -330,24 +362,33 @@ std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
     auto cache_entry = APPLICATION->metacache()->resolveEntry(
         metaEntryBase(),
         QString("logos/%1").arg(QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex())));
-    auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
-
     auto full_file_path = cache_entry->getFullPath();
-    connect(icon_fetch_action.get(), &Task::succeeded, this, [=] {
-        auto icon = QIcon(full_file_path);
-        QPixmapCache::insert(url.toString(), icon.pixmap(icon.actualSize({ 64, 64 })));
+    auto thumbnail_path = full_file_path + ".thumb.png";
 
-        m_currently_running_icon_actions.remove(url);
+    m_currently_running_icon_actions.insert(url);
 
-        emit dataChanged(index, index, { Qt::DecorationRole });
-    });
-    connect(icon_fetch_action.get(), &Task::failed, this, [=] {
+    // the thumbnail lives and dies with the logo it was made from, the metacache only knows about the logo
+    if (cache_entry->isStale()) {
+        QFile::remove(thumbnail_path);
+    } else if (QFileInfo::exists(thumbnail_path)) {
+        // the thumbnail of an earlier download is good enough, no need to ask the server again
+        decodeIcon(url, full_file_path, thumbnail_path, false);
+        return {};
+    }
+
+    if (!m_current_icon_job) {
+        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
+        m_current_icon_job->setAskRetry(false);
+    }
+
+    auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
+    connect(icon_fetch_action.get(), &Task::succeeded, this,
+            [this, url, full_file_path, thumbnail_path] { decodeIcon(url, full_file_path, thumbnail_path, true); });
+    connect(icon_fetch_action.get(), &Task::failed, this, [this, url] {
         m_currently_running_icon_actions.remove(url);
         m_failed_icon_actions.insert(url);
     });
 
-    m_currently_running_icon_actions.insert(url);
-
     m_current_icon_job->addNetAction(icon_fetch_action);
     if (!m_current_icon_job->isRunning())
         QMetaObject::invokeMethod(m_current_icon_job.get(), &NetJob::start);
@@ -355,6 +396,48 @@ std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
     return {};
 }
 
+void ResourceModel::decodeIcon(const QUrl& url, const QString& path, const QString& thumbnail_path, bool regenerate)
+{
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, url] {
+        auto image = watcher->result();
+        watcher->deleteLater();
+
+        m_currently_running_icon_actions.remove(url);
+        if (image.isNull()) {
+            m_failed_icon_actions.insert(url);
+            return;
+        }
+
+        m_icon_cache.insert(url, new QPixmap(QPixmap::fromImage(image)), qMax(1, static_cast<int>(image.sizeInBytes() / 1024)));
+        m_updated_icons.insert(url);
+        if (!m_icon_update_timer.isActive())
+            m_icon_update_timer.start();
+    });
+    watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(),
+                                         [path, thumbnail_path, regenerate] { return loadIconImage(path, thumbnail_path, regenerate); }));
+}
+
+void ResourceModel::flushIconUpdates()
+{
+    if (m_updated_icons.isEmpty())
+        return;
+
+    int first = -1;
+    int last = -1;
+    for (int row = 0; row < m_packs.size(); row++) {
+        if (!m_updated_icons.contains(QUrl(m_packs.at(row)->logoUrl)))
+            continue;
+        if (first == -1)
+            first = row;
+        last = row;
+    }
+    m_updated_icons.clear();
+
+    if (first != -1)
+        emit dataChanged(index(first), index(last), { Qt::DecorationRole });
+}
+
 // No 'forgor to implement' shall pass here :blobfox_knife:
 #define NEED_FOR_CALLBACK_ASSERT(name) \
     Q_ASSERT_X(0 != 0, #name, "You NEED to re-implement this if you intend on using the default callbacks.")
@@ -7,6 +7,8 @@
 #include <optional>
 
 #include <QAbstractListModel>
+#include <QCache>
+#include <QTimer>
 
 #include "QObjectPtr.h"
 
@@ -95,8 +97,8 @@ class ResourceModel : public QAbstractListModel {
     /** Schedule a refresh, clearing the current state. */
     void refresh();
 
-    /** Gets the icon at the URL for the given index. If it's not fetched yet, fetch it and update when fisinhed. */
-    std::optional<QIcon> getIcon(QModelIndex&, const QUrl&);
+    /** Gets the icon at the URL. If it's not fetched yet, fetch it and update the entries using it when finished. */
+    std::optional<QIcon> getIcon(const QUrl&);
 
     void addPack(ModPlatform::IndexedPack::Ptr pack,
                  ModPlatform::IndexedVersion& version,
@@ -151,6 +153,12 @@ class ResourceModel : public QAbstractListModel {
     QSet<QUrl> m_currently_running_icon_actions;
     QSet<QUrl> m_failed_icon_actions;
 
+    // decoded and downscaled icons, the cost is in kilobytes
+    QCache<QUrl, QPixmap> m_icon_cache{ 16 * 1024 };
+    // icons that finished loading since the views were last told, flushed once per frame
+    QSet<QUrl> m_updated_icons;
+    QTimer m_icon_update_timer;
+
     QList<ModPlatform::IndexedPack::Ptr> m_packs;
     QList<DownloadTaskPtr> m_selected;
 
@@ -169,6 +177,9 @@ class ResourceModel : public QAbstractListModel {
 
     void infoRequestSucceeded(QJsonDocument&, ModPlatform::IndexedPack&, const QModelIndex&);
 
+    void decodeIcon(const QUrl& url, const QString& path, const QString& thumbnail_path, bool regenerate);
+    void flushIconUpdates();
+
    signals:
     void versionListUpdated();
     void projectInfoUpdated();
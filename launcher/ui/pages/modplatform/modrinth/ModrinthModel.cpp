@@ -38,6 +38,7 @@
 
 #include "BuildConfig.h"
 #include "Json.h"
+#include "modplatform/helpers/CachedApiRequest.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
 #include "net/NetJob.h"
 #include "ui/widgets/ProjectItem.h"
@@ -349,11 +350,18 @@ void ModpackListModel::searchRequestForOneSucceeded(QJsonDocument& doc)
 
 void ModpackListModel::searchRequestFailed(QString reason)
 {
-    auto failed_action = dynamic_cast<NetJob*>(jobPtr.get())->getFailedActions().at(0);
-    if (failed_action->replyStatusCode() == -1) {
+    // the "#projectId" search runs through a CachedApiRequest, everything else through a plain NetJob
+    int status_code = -1;
+    if (auto request = qobject_cast<CachedApiRequest*>(jobPtr.get())) {
+        status_code = request->replyStatusCode();
+    } else if (auto job = qobject_cast<NetJob*>(jobPtr.get())) {
+        if (auto failed = job->getFailedActions(); !failed.isEmpty() && failed.first())
+            status_code = failed.first()->replyStatusCode();
+    }
+    if (status_code == -1) {
         // Network error
         QMessageBox::critical(nullptr, tr("Error"), tr("A network error occurred. Could not load modpacks."));
-    } else if (failed_action->replyStatusCode() == 409) {
+    } else if (status_code == 409) {
         // 409 Gone, notify user to update
         QMessageBox::critical(nullptr, tr("Error"),
                               //: %1 refers to the launcher itself
@@ -0,0 +1,310 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DeltaUpdate.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <algorithm>
+
+#include "FileSystem.h"
+#include "Json.h"
+#include "net/ChecksumValidator.h"
+#include "net/Download.h"
+#include "net/NetJob.h"
+
+namespace DeltaUpdate {
+
+const QString INSTALLED_MANIFEST = "update_manifest.json";
+const QString FILE_LIST = "manifest.txt";
+
+Manifest parseManifest(const QByteArray& data, const QUrl& manifestUrl)
+{
+    auto obj = Json::requireObject(Json::requireDocument(data, "Update manifest"), "Update manifest");
+    if (auto format = Json::requireInteger(obj, "formatVersion"); format != 1)
+        throw Json::JsonException(QString("Unsupported update manifest format %1").arg(format));
+
+    Manifest manifest;
+    manifest.version = Json::ensureString(obj, "version");
+    for (const QJsonValue& fileValue : Json::requireArray(obj, "files")) {
+        auto fileObj = Json::requireObject(fileValue, "Update manifest file");
+
+        FileEntry file;
+        file.path = QDir::cleanPath(Json::requireString(fileObj, "path"));
+        // never let a manifest write outside of the install
+        if (file.path.isEmpty() || QDir::isAbsolutePath(file.path) || file.path.startsWith(".."))
+            throw Json::JsonException(QString("Invalid path '%1' in update manifest").arg(file.path));
+        file.sha256 = Json::requireString(fileObj, "sha256").toLower();
+        file.size = static_cast<qint64>(Json::requireDouble(fileObj, "size"));
+        file.executable = Json::ensureBoolean(fileObj, "executable", false);
+        if (fileObj.contains("url")) {
+            file.url = Json::requireUrl(fileObj, "url");
+        } else {
+            QUrl relative;
+            relative.setPath(file.path);
+            file.url = manifestUrl.resolved(relative);
+        }
+        manifest.files.append(file);
+    }
+    return manifest;
+}
+
+QByteArray fileList(const Manifest& manifest)
+{
+    QStringList paths;
+    for (const auto& file : manifest.files)
+        paths.append(file.path);
+    // the lists shipped with releases name themselves too
+    paths.append(FILE_LIST);
+    paths.append(INSTALLED_MANIFEST);
+    paths.removeDuplicates();
+    return paths.join('\n').toUtf8() + '\n';
+}
+
+QList<FileEntry> changedFiles(const Manifest& manifest, const QDir& root)
+{
+    QList<FileEntry> changed;
+    for (const auto& file : manifest.files) {
+        QFileInfo info(root.absoluteFilePath(file.path));
+        // a size mismatch is enough to know the file changed without reading it
+        if (!info.isFile() || info.size() != file.size) {
+            changed.append(file);
+            continue;
+        }
+        QFile local(info.absoluteFilePath());
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        if (!local.open(QIODevice::ReadOnly) || !hash.addData(&local) || QString::fromLatin1(hash.result().toHex()) != file.sha256)
+            changed.append(file);
+    }
+    return changed;
+}
+
+QStringList removedFiles(const Manifest& installed, const Manifest& update)
+{
+    QSet<QString> kept;
+    for (const auto& file : update.files)
+        kept.insert(file.path);
+
+    QStringList removed;
+    for (const auto& file : installed.files) {
+        if (!kept.contains(file.path))
+            removed.append(file.path);
+    }
+    return removed;
+}
+
+bool swapIn(const QDir& staging, const QDir& root, const QList<FileEntry>& files, const QStringList& removed, const QDir& backup,
+            QString& error)
+{
+    // every step is recorded so a failure part way puts the install back as it was
+    struct Step {
+        QString target;
+        QString backup;
+        bool replaced;
+    };
+    QList<Step> done;
+
+    auto rollback = [&done]() {
+        for (auto it = done.crbegin(); it != done.crend(); ++it) {
+            if (it->replaced)
+                FS::deletePath(it->target);
+            if (!it->backup.isEmpty() && !FS::move(it->backup, it->target))
+                qWarning() << "Failed to restore" << it->target << "from" << it->backup;
+        }
+    };
+
+    auto moveAside = [&root, &backup](const QString& path) -> QString {
+        auto target = root.absoluteFilePath(path);
+        if (!QFileInfo::exists(target))
+            return {};
+        auto backupPath = backup.absoluteFilePath(path);
+        FS::deletePath(backupPath);
+        if (!FS::move(target, backupPath))
+            return QString();
+        return backupPath;
+    };
+
+    for (const auto& file : files) {
+        auto target = root.absoluteFilePath(file.path);
+        auto staged = staging.absoluteFilePath(file.path);
+
+        auto permissions = QFileInfo(target).permissions();
+        auto hadTarget = QFileInfo::exists(target);
+        auto backupPath = moveAside(file.path);
+        if (hadTarget && backupPath.isEmpty()) {
+            error = QObject::tr("Failed to back up %1").arg(target);
+            rollback();
+            return false;
+        }
+        done.append({ target, backupPath, true });
+
+        if (!FS::move(staged, target)) {
+            error = QObject::tr("Failed to move %1 into place").arg(target);
+            rollback();
+            return false;
+        }
+        // downloads are written without any special permissions, keep the ones of the replaced file
+        if (file.executable)
+            permissions |= QFile::ExeOwner | QFile::ExeGroup | QFile::ExeOther | QFile::ReadOwner | QFile::WriteOwner;
+        if (hadTarget || file.executable)
+            QFile::setPermissions(target, permissions);
+    }
+
+    for (const auto& path : removed) {
+        auto target = root.absoluteFilePath(path);
+        if (!QFileInfo::exists(target))
+            continue;
+        auto backupPath = moveAside(path);
+        if (backupPath.isEmpty()) {
+            error = QObject::tr("Failed to remove %1").arg(target);
+            rollback();
+            return false;
+        }
+        done.append({ target, backupPath, false });
+    }
+    return true;
+}
+
+DeltaUpdateTask::DeltaUpdateTask(QUrl manifestUrl, QString root, QString backup, shared_qobject_ptr<QNetworkAccessManager> network)
+    : m_manifestUrl(manifestUrl)
+    , m_root(root)
+    , m_backup(backup)
+    , m_staging(FS::PathCombine(root, ".prism_launcher_update_staging"))
+    , m_network(network)
+{}
+
+QStringList DeltaUpdateTask::updatedFiles() const
+{
+    QStringList paths;
+    for (const auto& file : m_changed)
+        paths.append(file.path);
+    return paths;
+}
+
+bool DeltaUpdateTask::abort()
+{
+    if (m_task && m_task->isRunning())
+        return m_task->abort();
+    emitAborted();
+    return true;
+}
+
+void DeltaUpdateTask::executeTask()
+{
+    setStatus(tr("Downloading update manifest"));
+    m_manifestData = std::make_shared<QByteArray>();
+
+    auto job = makeShared<NetJob>("Update manifest", m_network);
+    job->addNetAction(Net::Download::makeByteArray(m_manifestUrl, m_manifestData));
+    connect(job.get(), &Task::succeeded, this, &DeltaUpdateTask::manifestDownloaded);
+    connect(job.get(), &Task::failed, this, &DeltaUpdateTask::emitFailed);
+    connect(job.get(), &Task::aborted, this, &DeltaUpdateTask::emitAborted);
+    m_task = job;
+    job->start();
+}
+
+void DeltaUpdateTask::manifestDownloaded()
+{
+    try {
+        m_manifest = parseManifest(*m_manifestData, m_manifestUrl);
+    } catch (const Json::JsonException& e) {
+        emitFailed(tr("Failed to read the update manifest: %1").arg(e.cause()));
+        return;
+    }
+
+    setStatus(tr("Comparing installed files"));
+    m_changed = changedFiles(m_manifest, m_root);
+
+    Manifest installed;
+    auto installedPath = m_root.absoluteFilePath(INSTALLED_MANIFEST);
+    if (QFileInfo::exists(installedPath)) {
+        try {
+            installed = parseManifest(FS::read(installedPath));
+        } catch (const Exception& e) {
+            qWarning() << "Ignoring unreadable installed update manifest:" << e.cause();
+        }
+    }
+    m_removed = DeltaUpdate::removedFiles(installed, m_manifest);
+
+    qDebug() << m_changed.length() << "of" << m_manifest.files.length() << "files changed," << m_removed.length() << "removed";
+
+    FS::deletePath(m_staging.absolutePath());
+    if (m_changed.isEmpty()) {
+        filesDownloaded();
+        return;
+    }
+
+    setStatus(tr("Downloading %n changed file(s)", nullptr, m_changed.length()));
+    auto job = makeShared<NetJob>("Update files", m_network);
+    for (const auto& file : m_changed) {
+        auto staged = m_staging.absoluteFilePath(file.path);
+        auto dl = Net::Download::makeFile(file.url, staged);
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha256, file.sha256));
+        job->addNetAction(dl);
+    }
+    connect(job.get(), &Task::succeeded, this, &DeltaUpdateTask::filesDownloaded);
+    connect(job.get(), &Task::failed, this, [this](QString reason) {
+        FS::deletePath(m_staging.absolutePath());
+        emitFailed(reason);
+    });
+    connect(job.get(), &Task::aborted, this, [this] {
+        FS::deletePath(m_staging.absolutePath());
+        emitAborted();
+    });
+    connect(job.get(), &Task::progress, this, &DeltaUpdateTask::setProgress);
+    connect(job.get(), &Task::stepProgress, this, &DeltaUpdateTask::propagateStepProgress);
+    m_task = job;
+    job->start();
+}
+
+void DeltaUpdateTask::filesDownloaded()
+{
+    m_task.reset();
+    setStatus(tr("Installing update"));
+
+    QString error;
+    if (!swapIn(m_staging, m_root, m_changed, m_removed, m_backup, error)) {
+        FS::deletePath(m_staging.absolutePath());
+        emitFailed(error);
+        return;
+    }
+    FS::deletePath(m_staging.absolutePath());
+
+    try {
+        FS::write(m_root.absoluteFilePath(INSTALLED_MANIFEST), *m_manifestData);
+    } catch (const FS::FileSystemException& e) {
+        // only affects which files the next update removes
+        qWarning() << "Failed to record the installed update manifest:" << e.cause();
+    }
+
+    // a full update backs up and installs what the file list names, it has to know about the files added here
+    bool listShipped =
+        std::any_of(m_manifest.files.begin(), m_manifest.files.end(), [](const FileEntry& file) { return file.path == FILE_LIST; });
+    if (!listShipped) {
+        try {
+            FS::write(m_root.absoluteFilePath(FILE_LIST), fileList(m_manifest));
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to update the installed file list:" << e.cause();
+        }
+    }
+    emitSucceeded();
+}
+
+}  // namespace DeltaUpdate
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDir>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <memory>
+
+#include "QObjectPtr.h"
+#include "tasks/Task.h"
+
+/**
+ * Per file updates of an installation.
+ *
+ * A release can publish a manifest listing every file of the install together with its size and SHA-256.
+ * Only the files that differ from the installed tree are downloaded, and they are swapped in as a whole
+ * once all of them have been downloaded and verified.
+ *
+ * Manifest format:
+ * {
+ *     "formatVersion": 1,
+ *     "version": "9.0",
+ *     "files": [
+ *         { "path": "bin/prismlauncher", "sha256": "...", "size": 1234, "executable": true },
+ *         { "path": "share/icon.svg", "sha256": "...", "size": 56, "url": "https://..." }
+ *     ]
+ * }
+ *
+ * Files are downloaded from "url" when given, otherwise from "path" relative to the manifest itself,
+ * so a plain directory (or file:// url) holding the manifest next to the release tree works as a server.
+ */
+namespace DeltaUpdate {
+
+struct FileEntry {
+    QString path;
+    QString sha256;
+    qint64 size = 0;
+    bool executable = false;
+    QUrl url;
+};
+
+struct Manifest {
+    QString version;
+    QList<FileEntry> files;
+};
+
+/// name of the manifest of the installed files, kept in the install root to know what an update removes
+extern const QString INSTALLED_MANIFEST;
+
+/// name of the plain list of installed files the full updater backs up and installs from, one path per line
+extern const QString FILE_LIST;
+
+/// the file list matching the manifest, in the format of FILE_LIST
+QByteArray fileList(const Manifest& manifest);
+
+/// @throws Json::JsonException when the manifest is malformed
+Manifest parseManifest(const QByteArray& data, const QUrl& manifestUrl = {});
+
+/// the files of the manifest missing from or different in the root, compared by size before hashing
+QList<FileEntry> changedFiles(const Manifest& manifest, const QDir& root);
+
+/// the files listed in the installed manifest that are no longer part of the update
+QStringList removedFiles(const Manifest& installed, const Manifest& update);
+
+/**
+ * Moves the staged files over the install, and the removed files out of it.
+ * The replaced files are moved to the backup directory first, everything is put back if any step fails.
+ */
+bool swapIn(const QDir& staging, const QDir& root, const QList<FileEntry>& files, const QStringList& removed, const QDir& backup,
+            QString& error);
+
+class DeltaUpdateTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<DeltaUpdateTask>;
+
+    DeltaUpdateTask(QUrl manifestUrl, QString root, QString backup, shared_qobject_ptr<QNetworkAccessManager> network);
+
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+    QString version() const { return m_manifest.version; }
+    QStringList updatedFiles() const;
+    QStringList removedFiles() const { return m_removed; }
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void manifestDownloaded();
+    void filesDownloaded();
+
+    QUrl m_manifestUrl;
+    QDir m_root;
+    QDir m_backup;
+    QDir m_staging;
+    shared_qobject_ptr<QNetworkAccessManager> m_network;
+
+    std::shared_ptr<QByteArray> m_manifestData;
+    Manifest m_manifest;
+    QList<FileEntry> m_changed;
+    QStringList m_removed;
+    Task::Ptr m_task;
+};
+
+}  // namespace DeltaUpdate
@@ -22,6 +22,7 @@
 
 #include "PrismUpdater.h"
 #include "BuildConfig.h"
+#include "DeltaUpdate.h"
 #include "ui/dialogs/ProgressDialog.h"
 
 #include <cstdlib>
@@ -227,6 +228,9 @@ PrismUpdaterApp::PrismUpdaterApp(int& argc, char** argv) : QApplication(argc, ar
             tr("installed launcher version") },
           { { "I", "install-version" }, "Install a specific version.", tr("version name") },
           { { "U", "update-url" }, tr("Update from the specified repo."), tr("github repo url") },
+          { { "M", "manifest-url" },
+            tr("Update using the file manifest at this url or local path, only downloading the files that changed."),
+            tr("manifest url") },
           { { "c", "check-only" },
             tr("Only check if an update is needed. Exit status 100 if true, 0 if false (or non 0 if there was an error).") },
           { { "p", "pre-release" }, tr("Allow updating to pre-release releases") },
@@ -276,6 +280,9 @@ PrismUpdaterApp::PrismUpdaterApp(int& argc, char** argv) : QApplication(argc, ar
 
     m_prismRepoUrl = QUrl::fromUserInput(prism_update_url);
 
+    if (auto manifest_url = parser.value("manifest-url"); !manifest_url.isEmpty())
+        m_manifestUrl = QUrl::fromUserInput(manifest_url, QDir::currentPath());
+
     m_checkOnly = parser.isSet("check-only");
     m_forceUpdate = parser.isSet("force");
     m_printOnly = parser.isSet("list");
@@ -567,6 +574,12 @@ void PrismUpdaterApp::run()
     qDebug() << "Version channel:" << m_prsimVersionChannel;
     qDebug() << "Git Commit:" << m_prismGitCommit;
 
+    if (m_manifestUrl.isValid() && !m_checkOnly) {
+        if (!performDeltaUpdate(m_manifestUrl, {}))
+            showFatalErrorMessage(tr("Update Failed"), tr("Failed to update using the manifest at %1").arg(m_manifestUrl.toString()));
+        return;
+    }
+
     auto latest = getLatestRelease();
     qDebug() << "Latest release" << latest.version;
     auto need_update = needUpdate(latest);
@@ -636,7 +649,7 @@ void PrismUpdaterApp::moveAndFinishUpdate(QDir target)
     logUpdate("Waiting 2 seconds for resources to free");
     this->thread()->sleep(2);
 
-    auto manifest_path = FS::PathCombine(m_rootPath, "manifest.txt");
+    auto manifest_path = FS::PathCombine(m_rootPath, DeltaUpdate::FILE_LIST);
     QFileInfo manifest(manifest_path);
 
     auto app_dir = QDir(m_rootPath);
@@ -709,6 +722,11 @@ void PrismUpdaterApp::moveAndFinishUpdate(QDir target)
     progress.setValue(i);
     QCoreApplication::processEvents();
 
+    finishUpdate(target, error);
+}
+
+void PrismUpdaterApp::finishUpdate(QDir target, bool error)
+{
     if (error) {
         logUpdate(tr("There were errors installing the update."));
         auto fail_marker = FS::PathCombine(m_dataPath, ".prism_launcher_update.fail");
@@ -890,6 +908,21 @@ void PrismUpdaterApp::performUpdate(const GitHubRelease& release)
     }
 
     qDebug() << "will install" << selected_asset;
+
+    auto asset_name = selected_asset.name.toLower();
+    if (m_isPortable || asset_name.endsWith(".zip") || asset_name.endsWith(".tar.gz")) {
+        // archive installs can be updated file by file when the release publishes a manifest for the asset
+        auto manifest_name = selected_asset.name + ".manifest.json";
+        for (auto& asset : release.assets) {
+            if (asset.name != manifest_name)
+                continue;
+            if (performDeltaUpdate(QUrl(asset.browser_download_url), release.tag_name))
+                return;
+            logUpdate(tr("Falling back to installing the full release archive"));
+            break;
+        }
+    }
+
     auto file = downloadAsset(selected_asset);
 
     if (!file.exists()) {
@@ -988,9 +1021,8 @@ bool write_lock_file(const QString& path, QDateTime timestamp, QString from, QSt
     return true;
 }
 
-void PrismUpdaterApp::performInstall(QFileInfo file)
+bool PrismUpdaterApp::checkUpdateLock()
 {
-    qDebug() << "starting install";
     auto update_lock_path = FS::PathCombine(m_dataPath, ".prism_launcher_update.lock");
     QFileInfo update_lock(update_lock_path);
     if (update_lock.exists()) {
@@ -1027,9 +1059,19 @@ void PrismUpdaterApp::performInstall(QFileInfo file)
             case QMessageBox::RejectRole:
                 [[fallthrough]];
             default:
-                return showFatalErrorMessage(tr("Update Aborted"), tr("The update attempt was aborted"));
+                showFatalErrorMessage(tr("Update Aborted"), tr("The update attempt was aborted"));
+                return false;
         }
     }
+    return true;
+}
+
+void PrismUpdaterApp::performInstall(QFileInfo file)
+{
+    qDebug() << "starting install";
+    if (!checkUpdateLock())
+        return;
+    auto update_lock_path = FS::PathCombine(m_dataPath, ".prism_launcher_update.lock");
     clearUpdateLog();
 
     auto changelog_path = FS::PathCombine(m_dataPath, ".prism_launcher_update.changelog");
@@ -1055,6 +1097,45 @@ void PrismUpdaterApp::performInstall(QFileInfo file)
     }
 }
 
+bool PrismUpdaterApp::performDeltaUpdate(const QUrl& manifest_url, const QString& version)
+{
+    qDebug() << "starting delta update from" << manifest_url;
+    if (!checkUpdateLock())
+        return true;
+    clearUpdateLog();
+
+    if (!m_install_release.body.isEmpty()) {
+        auto changelog_path = FS::PathCombine(m_dataPath, ".prism_launcher_update.changelog");
+        FS::write(changelog_path, m_install_release.body.toUtf8());
+    }
+
+    auto update_lock_path = FS::PathCombine(m_dataPath, ".prism_launcher_update.lock");
+    write_lock_file(update_lock_path, QDateTime::currentDateTime(), m_prismVersion, version, m_rootPath, m_dataPath);
+    logUpdate(tr("Updating %1 from %2 using the manifest at %3").arg(m_rootPath, m_prismVersion, manifest_url.toString()));
+
+    auto backup_dir = backupDirPath();
+    auto backup_marker_path = FS::PathCombine(m_dataPath, ".prism_launcher_update_backup_path.txt");
+    FS::write(backup_marker_path, backup_dir.toUtf8());
+
+    auto task = makeShared<DeltaUpdate::DeltaUpdateTask>(manifest_url, m_rootPath, backup_dir, m_network);
+    auto progress_dialog = ProgressDialog();
+    progress_dialog.adjustSize();
+    progress_dialog.execWithTask(task.get());
+
+    if (!task->wasSuccessful()) {
+        logUpdate(tr("Update using the manifest failed: %1").arg(task->failReason()));
+        FS::deletePath(update_lock_path);
+        return false;
+    }
+
+    logUpdate(tr("Updated to %1, replaced:\n  %2").arg(task->version(), task->updatedFiles().join(",\n  ")));
+    if (!task->removedFiles().isEmpty())
+        logUpdate(tr("Removed:\n  %1").arg(task->removedFiles().join(",\n  ")));
+
+    finishUpdate(QDir(m_rootPath), false);
+    return true;
+}
+
 void PrismUpdaterApp::unpackAndInstall(QFileInfo archive)
 {
     logUpdate(tr("Backing up install"));
@@ -1088,9 +1169,18 @@ void PrismUpdaterApp::unpackAndInstall(QFileInfo archive)
     return exit(1);  // unpack failure
 }
 
+QString PrismUpdaterApp::backupDirPath()
+{
+    return FS::PathCombine(
+        QDir(m_rootPath).absolutePath(),
+        QStringLiteral("backup_") +
+            QString(m_prismVersion).replace(QRegularExpression("[" + QRegularExpression::escape("\\/:*?\"<>|") + "]"), QString("_")) + "-" +
+            m_prismGitCommit);
+}
+
 void PrismUpdaterApp::backupAppDir()
 {
-    auto manifest_path = FS::PathCombine(m_rootPath, "manifest.txt");
+    auto manifest_path = FS::PathCombine(m_rootPath, DeltaUpdate::FILE_LIST);
     QFileInfo manifest(manifest_path);
 
     QStringList file_list;
@@ -1132,11 +1222,7 @@ void PrismUpdaterApp::backupAppDir()
     }
     logUpdate(tr("Backing up:\n  %1").arg(file_list.join(",\n  ")));
     auto app_dir = QDir(m_rootPath);
-    auto backup_dir = FS::PathCombine(
-        app_dir.absolutePath(),
-        QStringLiteral("backup_") +
-            QString(m_prismVersion).replace(QRegularExpression("[" + QRegularExpression::escape("\\/:*?\"<>|") + "]"), QString("_")) + "-" +
-            m_prismGitCommit);
+    auto backup_dir = backupDirPath();
     FS::ensureFolderPathExists(backup_dir);
     auto backup_marker_path = FS::PathCombine(m_dataPath, ".prism_launcher_update_backup_path.txt");
     FS::write(backup_marker_path, backup_dir.toUtf8());
@@ -1283,6 +1369,11 @@ bool PrismUpdaterApp::loadPrismVersionFromExe(const QString& exe_path)
 
 void PrismUpdaterApp::loadReleaseList()
 {
+    if (m_manifestUrl.isValid() && !m_checkOnly) {
+        // the manifest was given directly, there is no release to look up
+        return run();
+    }
+
     auto github_repo = m_prismRepoUrl;
     if (github_repo.host() != "github.com")
         return fail("updating from a non github url is not supported");
@@ -79,7 +79,10 @@ class PrismUpdaterApp : public QApplication {
     GitHubReleaseAsset selectAsset(const QList<GitHubReleaseAsset>& assets);
     void performUpdate(const GitHubRelease& release);
     void performInstall(QFileInfo file);
+    bool performDeltaUpdate(const QUrl& manifest_url, const QString& version);
+    bool checkUpdateLock();
     void unpackAndInstall(QFileInfo file);
+    QString backupDirPath();
     void backupAppDir();
     std::optional<QDir> unpackArchive(QFileInfo file);
 
@@ -87,6 +90,7 @@ class PrismUpdaterApp : public QApplication {
     bool callAppImageUpdate();
 
     void moveAndFinishUpdate(QDir target);
+    void finishUpdate(QDir target, bool error);
 
    public slots:
     void downloadError(QString reason);
@@ -107,6 +111,7 @@ class PrismUpdaterApp : public QApplication {
     QString m_appimagePath;
     QString m_prismExecutable;
     QUrl m_prismRepoUrl;
+    QUrl m_manifestUrl;
     Version m_userSelectedVersion;
     bool m_checkOnly;
     bool m_forceUpdate;
@@ -0,0 +1,185 @@
+#include <QCryptographicHash>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimer>
+
+#include <FileSystem.h>
+#include <Json.h>
+#include <updater/prismupdater/DeltaUpdate.h>
+
+class DeltaUpdateTest : public QObject {
+    Q_OBJECT
+
+    static QString sha256(const QByteArray& data)
+    {
+        return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+    }
+
+    static QJsonObject fileEntry(const QString& path, const QByteArray& data)
+    {
+        return { { "path", path }, { "sha256", sha256(data) }, { "size", data.size() } };
+    }
+
+    // lays out a release the way it would be served: the manifest next to the release tree
+    static QUrl makeRelease(const QDir& server, const QMap<QString, QByteArray>& files, const QString& version)
+    {
+        QJsonArray entries;
+        for (auto it = files.cbegin(); it != files.cend(); ++it) {
+            FS::write(server.absoluteFilePath(it.key()), it.value());
+            entries.append(fileEntry(it.key(), it.value()));
+        }
+        QJsonObject manifest{ { "formatVersion", 1 }, { "version", version }, { "files", entries } };
+        auto manifestPath = server.absoluteFilePath("manifest.json");
+        FS::write(manifestPath, QJsonDocument(manifest).toJson());
+        return QUrl::fromLocalFile(manifestPath);
+    }
+
+    static bool runTask(DeltaUpdate::DeltaUpdateTask& task)
+    {
+        QEventLoop loop;
+        connect(&task, &Task::finished, &loop, &QEventLoop::quit);
+
+        QTimer expire_timer;
+        expire_timer.setSingleShot(true);
+        expire_timer.callOnTimeout(&loop, &QEventLoop::quit);
+        expire_timer.start(5000);
+
+        task.start();
+        if (task.isRunning())
+            loop.exec();
+        return task.wasSuccessful();
+    }
+
+   private slots:
+    void test_parseManifest()
+    {
+        auto data = QJsonDocument(QJsonObject{ { "formatVersion", 1 },
+                                               { "version", "9.0" },
+                                               { "files", QJsonArray{ fileEntry("bin/prismlauncher", "launcher"),
+                                                                      QJsonObject{ { "path", "lib/a.so" },
+                                                                                   { "sha256", sha256("a") },
+                                                                                   { "size", 1 },
+                                                                                   { "url", "https://example.com/a.so" } } } } })
+                        .toJson();
+        auto manifest = DeltaUpdate::parseManifest(data, QUrl("https://example.com/release/manifest.json"));
+
+        QCOMPARE(manifest.version, QString("9.0"));
+        QCOMPARE(manifest.files.length(), 2);
+        QCOMPARE(manifest.files[0].url, QUrl("https://example.com/release/bin/prismlauncher"));
+        QCOMPARE(manifest.files[1].url, QUrl("https://example.com/a.so"));
+
+        auto escaping = QJsonDocument(QJsonObject{ { "formatVersion", 1 }, { "files", QJsonArray{ fileEntry("../evil", "x") } } }).toJson();
+        QVERIFY_EXCEPTION_THROWN(DeltaUpdate::parseManifest(escaping), Json::JsonException);
+    }
+
+    void test_changedFiles()
+    {
+        QTemporaryDir install;
+        QDir root(install.path());
+        FS::write(root.absoluteFilePath("same"), "same");
+        FS::write(root.absoluteFilePath("resized"), "old");
+        FS::write(root.absoluteFilePath("edited"), "abcd");
+
+        DeltaUpdate::Manifest manifest;
+        manifest.files = { { "same", sha256("same"), 4 },
+                           { "resized", sha256("newer"), 5 },
+                           { "edited", sha256("dcba"), 4 },
+                           { "missing", sha256("new"), 3 } };
+
+        QStringList changed;
+        for (auto& file : DeltaUpdate::changedFiles(manifest, root))
+            changed.append(file.path);
+        QCOMPARE(changed, QStringList({ "resized", "edited", "missing" }));
+    }
+
+    void test_updateFromLocalDirectory()
+    {
+        QTemporaryDir server;
+        QTemporaryDir install;
+        QDir root(install.path());
+
+        FS::write(root.absoluteFilePath("bin/launcher"), "launcher 1");
+        FS::write(root.absoluteFilePath("lib/unchanged"), "unchanged");
+        FS::write(root.absoluteFilePath("lib/dropped"), "dropped");
+        FS::write(root.absoluteFilePath("UserData/config"), "user data");
+        // what the previous update installed
+        FS::write(root.absoluteFilePath(DeltaUpdate::INSTALLED_MANIFEST),
+                  QJsonDocument(QJsonObject{ { "formatVersion", 1 },
+                                             { "files", QJsonArray{ fileEntry("bin/launcher", "launcher 1"),
+                                                                    fileEntry("lib/unchanged", "unchanged"),
+                                                                    fileEntry("lib/dropped", "dropped") } } })
+                      .toJson());
+
+        auto manifestUrl = makeRelease(QDir(server.path()),
+                                       { { "bin/launcher", "launcher 2" }, { "lib/unchanged", "unchanged" }, { "lib/added", "added" } }, "2");
+
+        auto network = makeShared<QNetworkAccessManager>();
+        DeltaUpdate::DeltaUpdateTask task(manifestUrl, root.absolutePath(), root.absoluteFilePath("backup"), network);
+        QVERIFY2(runTask(task), qPrintable(task.failReason()));
+
+        QCOMPARE(task.version(), QString("2"));
+        QCOMPARE(task.updatedFiles(), QStringList({ "bin/launcher", "lib/added" }));
+        QCOMPARE(task.removedFiles(), QStringList({ "lib/dropped" }));
+
+        QCOMPARE(FS::read(root.absoluteFilePath("bin/launcher")), QByteArray("launcher 2"));
+        QCOMPARE(FS::read(root.absoluteFilePath("lib/added")), QByteArray("added"));
+        QCOMPARE(FS::read(root.absoluteFilePath("UserData/config")), QByteArray("user data"));
+        QVERIFY(!QFileInfo::exists(root.absoluteFilePath("lib/dropped")));
+
+        QCOMPARE(FS::read(root.absoluteFilePath("backup/bin/launcher")), QByteArray("launcher 1"));
+        QCOMPARE(FS::read(root.absoluteFilePath("backup/lib/dropped")), QByteArray("dropped"));
+        QVERIFY(!QFileInfo::exists(root.absoluteFilePath("backup/lib/unchanged")));
+        QVERIFY(!QFileInfo::exists(root.absoluteFilePath(".prism_launcher_update_staging")));
+
+        // the full updater reads the file list, it has to match what was installed
+        QCOMPARE(FS::read(root.absoluteFilePath(DeltaUpdate::FILE_LIST)),
+                 QByteArray("bin/launcher\nlib/added\nlib/unchanged\nmanifest.txt\nupdate_manifest.json\n"));
+    }
+
+    void test_badDownloadKeepsInstall()
+    {
+        QTemporaryDir server;
+        QTemporaryDir install;
+        QDir root(install.path());
+        FS::write(root.absoluteFilePath("bin/launcher"), "launcher 1");
+        FS::write(root.absoluteFilePath("lib/library"), "library 1");
+
+        QDir serverDir(server.path());
+        auto manifestUrl = makeRelease(serverDir, { { "bin/launcher", "launcher 2" }, { "lib/library", "library 2" } }, "2");
+        // the served file does not match the manifest anymore
+        FS::write(serverDir.absoluteFilePath("lib/library"), "corrupted");
+
+        auto network = makeShared<QNetworkAccessManager>();
+        DeltaUpdate::DeltaUpdateTask task(manifestUrl, root.absolutePath(), root.absoluteFilePath("backup"), network);
+        QVERIFY(!runTask(task));
+
+        QCOMPARE(FS::read(root.absoluteFilePath("bin/launcher")), QByteArray("launcher 1"));
+        QCOMPARE(FS::read(root.absoluteFilePath("lib/library")), QByteArray("library 1"));
+        QVERIFY(!QFileInfo::exists(root.absoluteFilePath(".prism_launcher_update_staging")));
+    }
+
+    void test_swapInRollsBack()
+    {
+        QTemporaryDir install;
+        QDir root(install.path());
+        QDir staging(root.absoluteFilePath("staging"));
+        FS::write(root.absoluteFilePath("a"), "old a");
+        FS::write(root.absoluteFilePath("b"), "old b");
+        FS::write(staging.absoluteFilePath("a"), "new a");
+        // nothing staged for b, so moving it into place fails after a was already swapped
+
+        QString error;
+        QVERIFY(!DeltaUpdate::swapIn(staging, root, { { "a", {}, 5 }, { "b", {}, 5 } }, {}, QDir(root.absoluteFilePath("backup")), error));
+        QVERIFY(!error.isEmpty());
+        QCOMPARE(FS::read(root.absoluteFilePath("a")), QByteArray("old a"));
+        QCOMPARE(FS::read(root.absoluteFilePath("b")), QByteArray("old b"));
+    }
+};
+
+QTEST_GUILESS_MAIN(DeltaUpdateTest)
+
+#include "DeltaUpdate_test.moc"
@@ -0,0 +1,95 @@
+#include <QTest>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "FileSystem.h"
+#include "Json.h"
+#include "modplatform/helpers/FileHashIndex.h"
+
+class FileHashIndexTest : public QObject {
+    Q_OBJECT
+
+    static QStringList indexedPaths(const QString& index_file)
+    {
+        QStringList paths;
+        for (auto value : Json::requireArray(Json::requireDocument(index_file)))
+            paths.append(Json::requireString(Json::requireObject(value), "path"));
+        return paths;
+    }
+
+   private slots:
+    void test_unchangedFileHit()
+    {
+        QTemporaryDir dir;
+        auto file = FS::PathCombine(dir.path(), "mod.jar");
+        FS::write(file, "mod contents");
+        auto index_file = FS::PathCombine(dir.path(), "index.json");
+
+        {
+            FileHashIndex index(index_file);
+            QVERIFY(!index.hash(QFileInfo(file), "sha1").has_value());
+            index.insert(QFileInfo(file), "sha1", "abc");
+            QCOMPARE(index.hash(QFileInfo(file), "sha1").value_or(QString()), QString("abc"));
+            QVERIFY(!index.hash(QFileInfo(file), "md5").has_value());
+            index.save();
+        }
+
+        // the hash survives across runs while the file stays the same
+        FileHashIndex index(index_file);
+        QCOMPARE(index.hash(QFileInfo(file), "sha1").value_or(QString()), QString("abc"));
+    }
+
+    void test_changedFileMiss()
+    {
+        QTemporaryDir dir;
+        auto file = FS::PathCombine(dir.path(), "mod.jar");
+        FS::write(file, "mod contents");
+
+        FileHashIndex index(FS::PathCombine(dir.path(), "index.json"));
+        index.insert(QFileInfo(file), "sha1", "abc");
+        index.insert(QFileInfo(file), "md5", "def");
+
+        // same size, only the modification time moves
+        QFile touched(file);
+        QVERIFY(touched.open(QIODevice::ReadWrite));
+        QVERIFY(touched.setFileTime(QFileInfo(file).lastModified().addSecs(60), QFileDevice::FileModificationTime));
+        touched.close();
+        QVERIFY(!index.hash(QFileInfo(file), "sha1").has_value());
+
+        FS::write(file, "other mod contents");
+        QVERIFY(!index.hash(QFileInfo(file), "sha1").has_value());
+        QVERIFY(!index.hash(QFileInfo(file), "md5").has_value());
+
+        // hashing the new contents drops the hashes of the old ones
+        index.insert(QFileInfo(file), "sha1", "ghi");
+        QCOMPARE(index.hash(QFileInfo(file), "sha1").value_or(QString()), QString("ghi"));
+        QVERIFY(!index.hash(QFileInfo(file), "md5").has_value());
+    }
+
+    void test_savePrunesMissingFiles()
+    {
+        QTemporaryDir dir;
+        auto kept = FS::PathCombine(dir.path(), "kept.jar");
+        auto removed = FS::PathCombine(dir.path(), "removed.jar");
+        FS::write(kept, "kept");
+        FS::write(removed, "removed");
+        auto index_file = FS::PathCombine(dir.path(), "index.json");
+
+        FileHashIndex index(index_file);
+        index.insert(QFileInfo(kept), "sha1", "abc");
+        index.insert(QFileInfo(removed), "sha1", "def");
+        index.save();
+        QCOMPARE(indexedPaths(index_file).size(), 2);
+
+        QVERIFY(QFile::remove(removed));
+        index.save();
+        QCOMPARE(indexedPaths(index_file), QStringList({ QFileInfo(kept).absoluteFilePath() }));
+    }
+};
+
+QTEST_GUILESS_MAIN(FileHashIndexTest)
+
+#include "FileHashIndex_test.moc"
@@ -157,6 +157,59 @@ Wrapperommand=)";
 #endif
     }
 
+    void test_QSettingsCompatibility_data()
+    {
+        QTest::addColumn<QVariant>("value");
+
+        QTest::newRow("plain") << QVariant("value");
+        QTest::newRow("unicode") << QVariant(QString("h") + QChar(0xE9) + "llo " + QChar(0x2713) + " " + QChar(0xD83D) + QChar(0xDE00));
+        QTest::newRow("special characters") << QVariant("val=\"$INST_JAVA\" -jar; ls, \\ #hash");
+        QTest::newRow("surrounding spaces") << QVariant("  spaced  ");
+        QTest::newRow("control characters") << QVariant("a\n\tb\r\x01" "c");
+        QTest::newRow("at sign") << QVariant("@Invalid()");
+        QTest::newRow("empty") << QVariant("");
+        QTest::newRow("int") << QVariant(42);
+        QTest::newRow("bool") << QVariant(true);
+        QTest::newRow("byte array") << QVariant(QByteArray("\x00\x01\xff binary", 11));
+        QTest::newRow("string list") << QVariant(QStringList{ "a", "b, c", " d " });
+        QTest::newRow("empty list") << QVariant(QStringList{});
+    }
+
+    void test_QSettingsCompatibility()
+    {
+        QFETCH(QVariant, value);
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        QString fileName = file.fileName();
+        file.close();
+
+        // what we write, QSettings has to understand
+        INIFile f1;
+        f1.set("key", value);
+        QVERIFY(f1.saveFile(fileName));
+        {
+            QSettings settings{ fileName, QSettings::Format::IniFormat };
+            QCOMPARE(settings.status(), QSettings::Status::NoError);
+            QCOMPARE(settings.value("key").toString(), value.toString());
+            QCOMPARE(settings.value("key").toStringList(), value.toStringList());
+            QCOMPARE(settings.value("ConfigVersion").toString(), "1.2");
+        }
+
+        // and the other way around
+        {
+            QSettings settings{ fileName, QSettings::Format::IniFormat };
+            settings.clear();
+            settings.setValue("ConfigVersion", "1.2");
+            settings.setValue("key", value);
+            settings.sync();
+        }
+        INIFile f2;
+        QVERIFY(f2.loadFile(fileName));
+        QCOMPARE(f2.get("key", "NOT SET").toString(), value.toString());
+        QCOMPARE(f2.get("key", "NOT SET").toStringList(), value.toStringList());
+    }
+
     void test_SaveAlreadyExistingFileWithSpecialCharsV1()
     {
         QString fileContent = R"(InstanceType=OneSix
@@ -34,6 +34,24 @@ class BasicTask_MultiStep : public Task {
     void executeTask() override {}
 };
 
+/* Reports some progress, then succeeds. Only used for testing. */
+class ProgressTask : public Task {
+    Q_OBJECT
+
+   public:
+    static const int s_num_ticks = 10;
+
+    ProgressTask() : Task(nullptr, false) {}
+
+   private:
+    void executeTask() override
+    {
+        for (int i = 1; i <= s_num_ticks; i++)
+            setProgress(i, s_num_ticks);
+        emitSucceeded();
+    }
+};
+
 class BigConcurrentTask : public ConcurrentTask {
     Q_OBJECT
 
@@ -245,6 +263,35 @@ class TaskTest : public QObject {
         QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
     }
 
+    void benchmark_concurrentProgress()
+    {
+        static const int s_num_tasks = 10000;
+
+        int step_updates = 0;
+        int state_updates = 0;
+
+        QBENCHMARK_ONCE
+        {
+            ConcurrentTask t(nullptr, "", s_num_tasks);
+            for (int i = 0; i < s_num_tasks; i++)
+                t.addTask(makeShared<ProgressTask>());
+
+            QObject::connect(&t, &Task::stepProgress, [&] { step_updates++; });
+            QObject::connect(&t, &Task::status, [&] { state_updates++; });
+
+            t.start();
+            QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 60000), "Task didn't finish as it should.");
+            QVERIFY(t.wasSuccessful());
+            QCOMPARE(t.getProgress(), s_num_tasks);
+        }
+
+        qDebug() << "Step progress updates:" << step_updates << "state updates:" << state_updates;
+
+        // every tick used to be forwarded, plus one update for every finished subtask
+        QVERIFY(step_updates < s_num_tasks * (ProgressTask::s_num_ticks + 1));
+        QVERIFY(state_updates < s_num_tasks);
+    }
+
     void test_stackOverflowInConcurrentTask()
     {
         QEventLoop loop;
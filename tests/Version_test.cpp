@@ -15,6 +15,8 @@
 
 #include <QTest>
 
+#include <algorithm>
+
 #include <Version.h>
 
 class VersionTest : public QObject {
@@ -178,6 +180,52 @@ class VersionTest : public QObject {
         QCOMPARE(v1 > v2, !lessThan && !equal);
         QCOMPARE(v1 == v2, equal);
     }
+
+    void benchmark_versionSort_data()
+    {
+        QTest::addColumn<bool>("preParsed");
+
+        QTest::newRow("parse in comparator") << false;
+        QTest::newRow("pre-parsed") << true;
+    }
+
+    void benchmark_versionSort()
+    {
+        QFETCH(bool, preParsed);
+
+        // roughly the shape of the Minecraft, Forge and NeoForge version lists
+        QStringList strings;
+        for (int minor = 0; minor <= 21; ++minor) {
+            for (int patch = 0; patch <= 6; ++patch) {
+                strings << QString("1.%1.%2").arg(minor).arg(patch) << QString("1.%1.%2-pre%3").arg(minor).arg(patch).arg(patch + 1)
+                        << QString("1.%1.%2-rc1").arg(minor).arg(patch);
+                for (int build = 0; build < 12; ++build) {
+                    strings << QString("%1.%2.%3").arg(minor + 20).arg(patch).arg(build * 7)
+                            << QString("1.%1.%2-%3.%4.%5").arg(minor).arg(patch).arg(minor + 30).arg(build).arg(patch * 11)
+                            << QString("%1.%2.%3-beta+mc1.%1").arg(minor).arg(patch).arg(build);
+                }
+            }
+            strings << QString("%1w%2a").arg(minor + 10).arg(minor * 2 + 10);
+        }
+
+        if (preParsed) {
+            QList<Version> parsed;
+            for (const auto& str : strings)
+                parsed << Version(str);
+
+            QBENCHMARK
+            {
+                auto versions = parsed;
+                std::sort(versions.begin(), versions.end());
+            }
+        } else {
+            QBENCHMARK
+            {
+                auto versions = strings;
+                std::sort(versions.begin(), versions.end(), [](const QString& a, const QString& b) { return Version(a) < Version(b); });
+            }
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(VersionTest)